@@ -9,6 +9,26 @@
 #include <concepts>
 #include <sys/mman.h>
 #include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <utility>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 template <auto Num>
 concept PowerOfTwoValue = std::unsigned_integral<decltype(Num)> && std::has_single_bit(Num);
@@ -18,6 +38,114 @@ concept Hashable = requires(T a) {
     { std::hash<T>{}(a) } -> std::convertible_to<std::size_t>;
 };
 
+/*  Heterogeneous lookup
+*   get() takes anything the key traits can hash & compare with a stored key, without building a KeyType
+*   std::string keys: std::string_view, const char*, std::span<const std::byte>
+*   Any key: Prehashed{hash, key}, the hash must come from prehash<KeyType>()
+*/
+template <typename KeyLike>
+struct Prehashed {
+    std::size_t hash;
+    KeyLike     key;
+};
+
+template <typename KeyType>
+struct TransparentHash {
+    using is_transparent = void;
+
+    std::size_t operator()(const KeyType& key) const noexcept { return std::hash<KeyType>{}(key); }
+
+    template <typename KeyLike>
+    std::size_t operator()(const Prehashed<KeyLike>& key) const noexcept { return key.hash; }
+};
+
+template <typename KeyType>
+struct TransparentEqual {
+    using is_transparent = void;
+
+    bool operator()(const KeyType& lhs, const KeyType& rhs) const noexcept { return lhs == rhs; }
+
+    template <typename KeyLike>
+    bool operator()(const KeyType& lhs, const Prehashed<KeyLike>& rhs) const noexcept { return (*this)(lhs, rhs.key); }
+
+    template <typename KeyLike>
+    bool operator()(const Prehashed<KeyLike>& lhs, const KeyType& rhs) const noexcept { return (*this)(rhs, lhs.key); }
+};
+
+namespace strings {
+    inline std::string_view as_view(std::string_view key) noexcept { return key; }
+    inline std::string_view as_view(std::span<const std::byte> key) noexcept {
+        return {reinterpret_cast<const char*>(key.data()), key.size()};
+    }
+
+    template <typename KeyLike>
+    std::string_view as_view(const Prehashed<KeyLike>& key) noexcept { return as_view(key.key); }
+}
+
+// std::hash<std::string> and std::hash<std::string_view> are equal for the same characters
+template <>
+struct TransparentHash<std::string> {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+    std::size_t operator()(const std::string& key) const noexcept { return (*this)(std::string_view(key)); }
+    std::size_t operator()(const char* key) const noexcept { return (*this)(std::string_view(key)); }
+    std::size_t operator()(std::span<const std::byte> key) const noexcept { return (*this)(strings::as_view(key)); }
+
+    template <typename KeyLike>
+    std::size_t operator()(const Prehashed<KeyLike>& key) const noexcept { return key.hash; }
+};
+
+template <>
+struct TransparentEqual<std::string> {
+    using is_transparent = void;
+
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs& lhs, const Rhs& rhs) const noexcept { return view(lhs) == view(rhs); }
+
+private:
+    static std::string_view view(std::string_view key) noexcept { return key; }
+    static std::string_view view(const std::string& key) noexcept { return key; }
+    static std::string_view view(const char* key) noexcept { return key; }
+    static std::string_view view(std::span<const std::byte> key) noexcept { return strings::as_view(key); }
+
+    template <typename KeyLike>
+    static std::string_view view(const Prehashed<KeyLike>& key) noexcept { return view(key.key); }
+};
+
+template <typename KeyType>
+struct key_traits {
+    using hasher = TransparentHash<KeyType>;
+    using key_equal = TransparentEqual<KeyType>;
+};
+
+template <typename KeyType, typename Lookup>
+concept LookupKeyFor = std::same_as<Lookup, KeyType> || (
+    requires(const typename key_traits<KeyType>::hasher& hash,
+             const typename key_traits<KeyType>::key_equal& equal,
+             const KeyType& stored, const Lookup& key) {
+        { hash(key) } -> std::convertible_to<std::size_t>;
+        { equal(stored, key) } -> std::convertible_to<bool>;
+    });
+
+template <typename KeyType, typename KeyLike>
+requires LookupKeyFor<KeyType, KeyLike>
+Prehashed<KeyLike> prehash(const KeyLike& key) noexcept {
+    return {typename key_traits<KeyType>::hasher{}(key), key};
+}
+
+/*  Batched puts
+*   Caches take (key, value) pairs or pointers to them: sharded wrappers group a batch
+*   by shard without copying values
+*/
+namespace batch {
+    template <typename T>
+    const T& deref(const T& item) noexcept { return item; }
+
+    template <typename T>
+    const T& deref(const T* item) noexcept { return *item; }
+}
+
 namespace sizes { // It needs to be in Units.h
     static inline constexpr size_t KiB = 1024;
     static inline constexpr size_t MiB = KiB * 1024;
@@ -81,7 +209,143 @@ protected:
     ~NonCopyableNonMoveable() = default;
 };
 
-template <typename KeyType, typename ValueType, std::size_t Capacity = 1024>
+struct LockStats {
+    uint64_t acquisitions = 0;
+    uint64_t spins = 0;         // pause instructions burned before the lock was taken
+    uint64_t parks = 0;         // futex sleeps
+};
+
+/*  Writer lock: bounded spin with exponential backoff, then parking on atomic::wait (futex)
+*   Oversubscribed writers sleep instead of burning the CPU the lock holder needs
+*   Fifo = false:   0 free, 1 locked, 2 locked with sleepers (Drepper's mutex), barging allowed
+*   Fifo = true:    ticket lock, strict handoff in arrival order, no starvation of parked writers
+*   lock() returns the amount of spins: contention signal for the caller
+*   Counters are updated by the owner only, stats() is a relaxed snapshot
+*/
+template <bool Fifo = false>
+class HybridLock : private NonCopyableNonMoveable {
+    static constexpr uint32_t SpinLimit = 1024;    // Pauses before parking, ~ a few us
+    static constexpr uint32_t MaxBackoff = 64;
+
+    static uint32_t backoff(uint32_t& step) noexcept {
+        for (uint32_t i = 0; i < step; ++i) {
+            __builtin_ia32_pause();
+        }
+        const uint32_t spent = step;
+        step = std::min(step * 2, MaxBackoff);
+        return spent;
+    }
+
+    void note(uint32_t spins, uint32_t parks) noexcept {
+        _acquisitions.store(_acquisitions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (spins) _spins.store(_spins.load(std::memory_order_relaxed) + spins, std::memory_order_relaxed);
+        if (parks) _parks.store(_parks.load(std::memory_order_relaxed) + parks, std::memory_order_relaxed);
+    }
+
+public:
+    HybridLock() = default;
+
+    uint32_t lock() noexcept {
+        uint32_t spins = 0;
+        uint32_t parks = 0;
+        uint32_t step = 1;
+
+        if constexpr (Fifo) {
+            const uint32_t ticket = _next.fetch_add(1, std::memory_order_relaxed);
+
+            while (_serving.load(std::memory_order_acquire) != ticket) {
+                if (spins < SpinLimit) [[likely]] {
+                    spins += backoff(step);
+                    continue;
+                }
+
+                _parked.fetch_add(1, std::memory_order_seq_cst);
+                uint32_t serving = _serving.load(std::memory_order_seq_cst);
+                while (serving != ticket) {
+                    parks++;
+                    _serving.wait(serving, std::memory_order_acquire);
+                    serving = _serving.load(std::memory_order_acquire);
+                }
+                _parked.fetch_sub(1, std::memory_order_relaxed);
+            }
+        } else {
+            uint32_t state = 0;
+            if (_state.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_relaxed)) [[likely]] {
+                note(0, 0);
+                return 0;
+            }
+
+            while (spins < SpinLimit) {
+                spins += backoff(step);
+                state = _state.load(std::memory_order_relaxed);
+                if (state == 0 && _state.compare_exchange_weak(state, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    note(spins, 0);
+                    return spins;
+                }
+            }
+
+            // Mark "sleepers present" so the owner knows to wake us up
+            if (state != 2) state = _state.exchange(2, std::memory_order_acquire);
+            while (state != 0) {
+                parks++;
+                _state.wait(2, std::memory_order_relaxed);
+                state = _state.exchange(2, std::memory_order_acquire);
+            }
+        }
+
+        note(spins, parks);
+        return spins;
+    }
+
+    bool try_lock() noexcept {
+        bool taken;
+        if constexpr (Fifo) {
+            uint32_t ticket = _serving.load(std::memory_order_acquire);   // Pairs with unlock(): the last owner's writes
+            taken = _next.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire, std::memory_order_relaxed);
+        } else {
+            uint32_t state = 0;
+            taken = _state.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+        if (taken) note(0, 0);
+        return taken;
+    }
+
+    void unlock() noexcept {
+        if constexpr (Fifo) {
+            _serving.fetch_add(1, std::memory_order_seq_cst);
+            if (_parked.load(std::memory_order_seq_cst)) [[unlikely]] {
+                _serving.notify_all(); // Sleepers wait for different tickets
+            }
+        } else {
+            if (_state.exchange(0, std::memory_order_release) == 2) [[unlikely]] {
+                _state.notify_one();
+            }
+        }
+    }
+
+    LockStats stats() const noexcept {
+        return {_acquisitions.load(std::memory_order_relaxed),
+                _spins.load(std::memory_order_relaxed),
+                _parks.load(std::memory_order_relaxed)};
+    }
+
+private:
+    std::atomic<uint32_t>   _state{0};      // !Fifo
+    std::atomic<uint32_t>   _next{0};       // Fifo
+    std::atomic<uint32_t>   _serving{0};    // Fifo
+    std::atomic<uint32_t>   _parked{0};     // Fifo
+
+    std::atomic<uint64_t>   _acquisitions{0};
+    std::atomic<uint64_t>   _spins{0};
+    std::atomic<uint64_t>   _parks{0};
+};
+
+template <typename L>
+concept CountingLock = requires(const L& lock) {
+    { lock.stats() } -> std::same_as<LockStats>;
+};
+
+template <typename KeyType, typename ValueType, std::size_t Capacity = 1024, typename Lock = std::mutex>
 class StrictLRU : private NonCopyableNonMoveable{    // Use EBO
 public:
     static constexpr const char* name() noexcept { return "StrictLRU"; }
@@ -92,7 +356,8 @@ private:
     static_assert(Capacity > 0);
 
     using cacheList = std::list<std::pair<KeyType, ValueType>>;
-    using cacheMap = std::unordered_map<KeyType, typename cacheList::iterator>;
+    using cacheMap = std::unordered_map<KeyType, typename cacheList::iterator,
+                                        typename key_traits<KeyType>::hasher, typename key_traits<KeyType>::key_equal>;
 
     void refresh(typename cacheMap::iterator it) {
         _freq_list.splice(_freq_list.begin(), _freq_list, it->second);
@@ -101,8 +366,12 @@ private:
 public:
     StrictLRU() { _collection.reserve(Capacity); }
 
-    std::optional<ValueType> get(const KeyType& key) noexcept {
-        std::lock_guard<std::mutex> lock(_mtx);
+    std::optional<ValueType> get(const KeyType& key) noexcept { return get<KeyType>(key); }
+
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    std::optional<ValueType> get(const K& key) noexcept {
+        std::lock_guard<Lock> lock(_mtx);
         auto it = _collection.find(key);
         if (it == _collection.end()) return {};
         refresh(it);
@@ -111,7 +380,7 @@ public:
 
     template <typename T>
     void put(const KeyType& key, T&& value) {
-        std::lock_guard<std::mutex> lock(_mtx);
+        std::lock_guard<Lock> lock(_mtx);
         auto it = _collection.find(key);
         if (it != _collection.end()) {
             it->second->second = std::forward<T>(value);
@@ -126,13 +395,15 @@ public:
         }
     }
 
+    LockStats lock_stats() const noexcept requires CountingLock<Lock> { return _mtx.stats(); }
+
 private:
-    std::mutex  _mtx;
+    Lock        _mtx;
     cacheList   _freq_list;         // key, value
     cacheMap    _collection;        // key, cacheList::iterator
 };
 
-template <typename KeyType, typename ValueType, std::size_t Capacity = 1024>
+template <typename KeyType, typename ValueType, std::size_t Capacity = 1024, typename Lock = HybridLock<>>
 class SpinlockedLRU : private NonCopyableNonMoveable{    // Use EBO
 public:
     static constexpr const char* name() noexcept { return "SpinlockedLRU"; }
@@ -143,14 +414,8 @@ private:
     static_assert(Capacity > 0);
 
     using cacheList = std::list<std::pair<KeyType, ValueType>>;
-    using cacheMap = std::unordered_map<KeyType, typename cacheList::iterator>;
-
-private:    
-    struct SpinLock {
-        std::atomic_flag flag = ATOMIC_FLAG_INIT;
-        void lock() noexcept { while (flag.test_and_set(std::memory_order_acquire)); } // Spinlock
-        void unlock() noexcept { flag.clear(std::memory_order_release); }
-    };
+    using cacheMap = std::unordered_map<KeyType, typename cacheList::iterator,
+                                        typename key_traits<KeyType>::hasher, typename key_traits<KeyType>::key_equal>;
 
     void refresh(typename cacheMap::iterator it) {
         _freq_list.splice(_freq_list.begin(), _freq_list, it->second);
@@ -159,7 +424,11 @@ private:
 public:
     SpinlockedLRU() { _collection.reserve(Capacity); }
 
-    std::optional<ValueType> get(const KeyType& key) noexcept {
+    std::optional<ValueType> get(const KeyType& key) noexcept { return get<KeyType>(key); }
+
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    std::optional<ValueType> get(const K& key) noexcept {
         _lock.lock();
         auto it = _collection.find(key);
         if (it == _collection.end()) {
@@ -190,79 +459,130 @@ public:
         _lock.unlock();
     }
 
+    LockStats lock_stats() const noexcept requires CountingLock<Lock> { return _lock.stats(); }
+
 private:
-    SpinLock    _lock;
+    Lock        _lock;
     cacheList   _freq_list;         // key, value
     cacheMap    _collection;        // key, cacheList::iterator
 };
 
 
-/* It has:  False Sharing resolved with alignas
+/* Bounded MPMC queue (Vyukov): every cell has a sequence number, so a slot is published
+*           only after its value is written, and producers share nothing but the enqueue index
+*           False Sharing resolved with alignas
 *           array
-*           acq-rel fence
+*           acq-rel on the cell sequence, relaxed CAS on the indices
 *           division using bitwise "AND"
 */
 template <typename ValueType, std::size_t Capacity>
 requires PowerOfTwoValue<Capacity>
-class MPSC_TraceBuffer : private NonCopyableNonMoveable{    // Use EBO
+class MPMC_BoundedQueue : private NonCopyableNonMoveable{    // Use EBO
 public:
-    static constexpr const char* name() noexcept { return "MPSC_TraceBuffer"; }
+    static constexpr const char* name() noexcept { return "MPMC_BoundedQueue"; }
     using value_type = ValueType;
 
 private:
     static constexpr std::size_t CacheLine = sizes::CacheLine;
     static constexpr std::size_t Mask = Capacity - 1;
-    static_assert(std::has_single_bit(Capacity), "Capacity must be power of 2");
+    static_assert(Capacity >= 2, "Capacity must be at least 2");
+
+    struct Cell {
+        std::atomic<std::size_t>    seq;    // pos: free for the push at pos, pos + 1: filled by it
+        ValueType                   value;
+    };
+
+    static std::ptrdiff_t lag(std::size_t seq, std::size_t pos) noexcept {
+        return static_cast<std::ptrdiff_t>(seq - pos);
+    }
 
 public:
+    MPMC_BoundedQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) buffer[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Approximate: the indices are read at different moments
+    std::size_t size() const noexcept {
+        const std::size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+        const std::size_t head = dequeue_pos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
     bool isItTime() const noexcept {
-        return (tail - head > (Capacity / 2));
+        return size() > Capacity / 2;
     }
 
     bool push(const ValueType& value) {
-        std::size_t curr_t = tail.load(std::memory_order_relaxed);
-        while (true) { // CAS
-            if (((curr_t + 1) & Mask) == head_cache) {
-                head_cache = head.load(std::memory_order_acquire);
-                if (((curr_t + 1) & Mask) == head_cache) {
-                    return false;
-                }
-            }
+        std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &buffer[pos & Mask];
+            const std::ptrdiff_t diff = lag(cell->seq.load(std::memory_order_acquire), pos); // MB on
 
-            // Write
-            if (tail.compare_exchange_weak(curr_t, (curr_t + 1) & Mask,
-                                         std::memory_order_release,         // MB off
-                                         std::memory_order_relaxed)) {
-                buffer[curr_t] = value;
-                return true;
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Full: the cell still holds the value from a lap ago
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
             }
         }
+
+        cell->value = value;
+        cell->seq.store(pos + 1, std::memory_order_release); // MB off
+        return true;
     }
 
     bool pop(ValueType& value) {
-        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &buffer[pos & Mask];
+            const std::ptrdiff_t diff = lag(cell->seq.load(std::memory_order_acquire), pos + 1); // MB on
 
-        if (curr_h == tail_cache) {
-            tail_cache = tail.load(std::memory_order_acquire); // MB on
-            if (curr_h == tail_cache) return false;
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Empty, or the producer of this cell hasn't finished yet
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
         }
 
-        value = buffer[curr_h];
-        head.store((curr_h + 1) & Mask, std::memory_order_release); // MB off
-
+        value = std::move(cell->value);
+        cell->seq.store(pos + Capacity, std::memory_order_release); // MB off
         return true;
     }
 
+    // Batch: claims the run of filled cells at the head with one CAS
+    std::size_t pop_n(std::span<ValueType> out) {
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        std::size_t n = 0;
+        while (true) {
+            n = 0;
+            while (n < out.size() && lag(buffer[(pos + n) & Mask].seq.load(std::memory_order_acquire), pos + n + 1) == 0) {
+                ++n;
+            }
+            if (n == 0) return 0;
+            if (dequeue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) break;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            Cell& cell = buffer[(pos + i) & Mask];
+            out[i] = std::move(cell.value);
+            cell.seq.store(pos + i + Capacity, std::memory_order_release); // MB off
+        }
+        return n;
+    }
+
 private:
-    alignas(CacheLine) ValueType buffer[Capacity];
+    alignas(CacheLine) Cell buffer[Capacity];
 
-    // Producer's group
-    alignas(CacheLine) std::atomic<std::size_t> tail{0};
-    std::size_t head_cache{0}; // local
+    // Producers' group
+    alignas(CacheLine) std::atomic<std::size_t> enqueue_pos{0};
 
-    // Consumer's group
-    alignas(CacheLine) std::atomic<std::size_t> head{0};
-    std::size_t tail_cache{0}; // local
+    // Consumers' group
+    alignas(CacheLine) std::atomic<std::size_t> dequeue_pos{0};
 };
 
 
@@ -284,17 +604,20 @@ private:
     static_assert(Capacity > 0);
 
     using cacheList = std::list<std::pair<KeyType, ValueType>>;
-    using cacheMap = std::unordered_map<KeyType, typename cacheList::iterator>;
-    using ringBuffer = MPSC_TraceBuffer<KeyType, Capacity / 4>;
+    using cacheMap = std::unordered_map<KeyType, typename cacheList::iterator,
+                                        typename key_traits<KeyType>::hasher, typename key_traits<KeyType>::key_equal>;
+    using ringBuffer = MPMC_BoundedQueue<KeyType, Capacity / 4>;
 
 private:
     void apply_updates() {
 
-        KeyType key_to_refresh;
-        while (_update_buffer.pop(key_to_refresh)) { // It is safe because value is stored in _collection
-            auto it = _collection.find(key_to_refresh);
-            if (it != _collection.end()) {
-                _freq_list.splice(_freq_list.begin(), _freq_list, it->second);
+        std::array<KeyType, 32> keys;   // One CAS per run of traced keys
+        while (const std::size_t n = _update_buffer.pop_n(keys)) { // It is safe because value is stored in _collection
+            for (std::size_t i = 0; i < n; ++i) {
+                auto it = _collection.find(keys[i]);
+                if (it != _collection.end()) {
+                    _freq_list.splice(_freq_list.begin(), _freq_list, it->second);
+                }
             }
         }
     }
@@ -302,7 +625,11 @@ private:
 public:
     DeferredLRU() { _collection.reserve(Capacity); }
 
-    std::optional<ValueType> get(const KeyType& key) noexcept {
+    std::optional<ValueType> get(const KeyType& key) noexcept { return get<KeyType>(key); }
+
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    std::optional<ValueType> get(const K& key) noexcept {
         std::shared_lock lock(_rw_mtx);
 
         auto it = _collection.find(key);
@@ -310,7 +637,7 @@ public:
 
         // Admission of losses
         // Accumulate updates
-        _update_buffer.push(key);
+        _update_buffer.push(it->first); // Stored key: the lookup one may be a view
 
         return it->second->second;
     }
@@ -443,16 +770,18 @@ private:
 
     using cacheList = std::list<std::pair<KeyType, ValueType>>;
     using cacheMap = LinearFlatMap<KeyType, typename cacheList::iterator, Capacity>;
-    using ringBuffer = MPSC_TraceBuffer<KeyType, Capacity / 4>;
+    using ringBuffer = MPMC_BoundedQueue<KeyType, Capacity / 4>;
 
 private:
     void apply_updates() {
 
-        KeyType key_to_refresh;
-        while (_update_buffer.pop(key_to_refresh)) { // It is safe because value is stored in _collection
-            auto it = _collection.find(key_to_refresh);
-            if (it) {
-                _freq_list.splice(_freq_list.begin(), _freq_list, *it);
+        std::array<KeyType, 32> keys;   // One CAS per run of traced keys
+        while (const std::size_t n = _update_buffer.pop_n(keys)) { // It is safe because value is stored in _collection
+            for (std::size_t i = 0; i < n; ++i) {
+                auto it = _collection.find(keys[i]);
+                if (it) {
+                    _freq_list.splice(_freq_list.begin(), _freq_list, *it);
+                }
             }
         }
     }
@@ -529,8 +858,9 @@ private:
     static_assert(std::has_single_bit(ShardsCount), "ShardsCount must be power of 2");
     static_assert(std::has_single_bit(alignof(Cache)), "Alignment must be power of 2");
 
-    std::size_t get_shard_idx(const KeyType& key) const noexcept {
-        return std::hash<KeyType>{}(key) & Mask;
+    template <typename K>
+    std::size_t get_shard_idx(const K& key) const noexcept {
+        return typename key_traits<KeyType>::hasher{}(key) & Mask;
     }
 
 public:
@@ -541,7 +871,11 @@ public:
         }
     }
 
-    std::optional<ValueType> get(const KeyType& key) noexcept {
+    std::optional<ValueType> get(const KeyType& key) noexcept { return get<KeyType>(key); }
+
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    std::optional<ValueType> get(const K& key) noexcept {
         return _shards[get_shard_idx(key)]->get(key);
     }
 
@@ -550,6 +884,34 @@ public:
         _shards[get_shard_idx(key)]->put(key, std::forward<T>(value));
     }
 
+    // Grouped by shard: one lock hold (and one epoch bump) per touched shard
+    void put_many(std::span<const std::pair<KeyType, ValueType>> items) {
+        std::array<std::vector<const std::pair<KeyType, ValueType>*>, ShardsCount> groups;
+        for (const auto& item : items) {
+            groups[get_shard_idx(item.first)].push_back(&item);
+        }
+
+        for (std::size_t i = 0; i < ShardsCount; ++i) {
+            if (groups[i].empty()) continue;
+            _shards[i]->put_many(std::span<const std::pair<KeyType, ValueType>* const>(groups[i]));
+        }
+    }
+
+    bool erase(const KeyType& key) {
+        return _shards[get_shard_idx(key)]->erase(key);
+    }
+
+    template <typename P>
+    std::size_t erase_if(P&& pred) {
+        std::size_t erased = 0;
+        for (auto& shard : _shards) erased += shard->erase_if(pred);
+        return erased;
+    }
+
+    void clear() {
+        for (auto& shard : _shards) shard->clear();
+    }
+
 private:
     std::vector<std::unique_ptr<Cache>> _shards;
 };
@@ -603,6 +965,58 @@ public:
         return true;
     }
 
+    // Bulk: as many items as fit, contiguous runs around the wrap, tail published once
+    std::size_t push_n(std::span<const ValueType> items) {
+        const std::size_t curr_t = tail.load(std::memory_order_relaxed);
+
+        std::size_t free = (head_cache - curr_t - 1) & (Capacity - 1);
+        if (free < items.size()) {
+            head_cache = head.load(std::memory_order_acquire); // MB on
+            free = (head_cache - curr_t - 1) & (Capacity - 1);
+        }
+
+        const std::size_t n = std::min(free, items.size());
+        const std::size_t first = std::min(n, Capacity - curr_t);
+        std::copy_n(items.begin(), first, buffer + curr_t);
+        std::copy_n(items.begin() + first, n - first, buffer);
+        tail.store((curr_t + n) & (Capacity - 1), std::memory_order_release); // MB off
+
+        return n;
+    }
+
+    std::size_t pop_n(std::span<ValueType> out) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+
+        std::size_t ready = (tail_cache - curr_h) & (Capacity - 1);
+        if (ready < out.size()) {
+            tail_cache = tail.load(std::memory_order_acquire); // MB on
+            ready = (tail_cache - curr_h) & (Capacity - 1);
+        }
+
+        const std::size_t n = std::min(ready, out.size());
+        const std::size_t first = std::min(n, Capacity - curr_h);
+        std::copy_n(buffer + curr_h, first, out.begin());
+        std::copy_n(buffer, n - first, out.begin() + first);
+        head.store((curr_h + n) & (Capacity - 1), std::memory_order_release); // MB off
+
+        return n;
+    }
+
+    // Drains what is there now in place: no copies, head published once (the slots stay busy until the end)
+    template <typename F>
+    std::size_t consume_all(F&& func) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+        tail_cache = tail.load(std::memory_order_acquire); // MB on
+
+        const std::size_t n = (tail_cache - curr_h) & (Capacity - 1);
+        const std::size_t first = std::min(n, Capacity - curr_h);
+        for (std::size_t i = 0; i < first; ++i) func(std::as_const(buffer[curr_h + i]));
+        for (std::size_t i = 0; i < n - first; ++i) func(std::as_const(buffer[i]));
+        if (n) head.store(tail_cache, std::memory_order_release); // MB off
+
+        return n;
+    }
+
 private:
     alignas(CacheLine) ValueType buffer[Capacity];
 
@@ -615,6 +1029,129 @@ private:
     std::size_t tail_cache{0}; // local
 };
 
+enum class TraceOverflow : uint8_t { DropNewest, OverwriteOldest };
+
+struct TraceStats {
+    uint64_t dropped = 0;       // DropNewest: pushes refused by a full ring
+    uint64_t overwritten = 0;   // OverwriteOldest: records the consumer was lapped on
+};
+
+/*  SPSC ring for access traces, the producer (a reader of the cache) never waits for the consumer
+*   OverwriteOldest: a full ring overwrites its oldest records, the newest accesses always survive
+*   DropNewest: a full ring refuses the push, as SPSC_RingBufferUltraFast does
+*   Every slot is a seqlock stamped with its position: the consumer sees by itself that it was lapped,
+*   jumps to the oldest intact record and counts what it missed
+*   Slots are copied optimistically and validated afterwards, hence trivially copyable ValueType
+*/
+template <typename ValueType, std::size_t Capacity, TraceOverflow Overflow = TraceOverflow::OverwriteOldest>
+requires PowerOfTwoValue<Capacity> && std::is_trivially_copyable_v<ValueType>
+class SPSC_TraceRing : private NonCopyableNonMoveable {
+
+    static constexpr std::size_t CacheLine = sizes::CacheLine;
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    struct Slot {
+        std::atomic<std::size_t>    seq{0};     // stamp(pos) when written, odd while being written
+        ValueType                   value;
+    };
+
+    static constexpr std::size_t stamp(std::size_t pos) noexcept { return 2 * pos + 2; }
+
+    // The producer went a lap ahead: resume from the oldest record still in the ring (validated as usual)
+    std::size_t skip_lapped(std::size_t pos) noexcept {
+        const std::size_t t = tail.load(std::memory_order_acquire);
+        const std::size_t next = t > pos + Capacity ? t - Capacity : pos + 1;
+
+        overwritten.store(overwritten.load(std::memory_order_relaxed) + (next - pos), std::memory_order_relaxed);
+        head.store(next, std::memory_order_release);
+        return next;
+    }
+
+public:
+    using value_type = ValueType;
+
+    // Always true for OverwriteOldest
+    bool push(const ValueType& value) noexcept {
+        const std::size_t pos = tail.load(std::memory_order_relaxed);
+
+        if constexpr (Overflow == TraceOverflow::DropNewest) {
+            if (pos - head_cache >= Capacity) {
+                head_cache = head.load(std::memory_order_acquire); // MB on
+                if (pos - head_cache >= Capacity) {
+                    dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+        }
+
+        Slot& slot = buffer[pos & Mask];
+        slot.seq.store(stamp(pos) - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = value;
+        slot.seq.store(stamp(pos), std::memory_order_release);
+        tail.store(pos + 1, std::memory_order_release); // MB off
+
+        return true;
+    }
+
+    bool pop(ValueType& value) noexcept {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+
+        while (true) {
+            const Slot& slot = buffer[pos & Mask];
+            const std::size_t seq = slot.seq.load(std::memory_order_acquire); // MB on
+            if (seq < stamp(pos)) return false;     // Previous lap or being written: empty
+
+            if (seq == stamp(pos)) {
+                value = slot.value;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) == seq) [[likely]] {
+                    head.store(pos + 1, std::memory_order_release); // MB off
+                    return true;
+                }
+            }
+
+            pos = skip_lapped(pos);
+        }
+    }
+
+    // Drains what is there now, records pushed meanwhile wait for the next call
+    template <typename F>
+    std::size_t consume_all(F&& func) {
+        const std::size_t end = tail.load(std::memory_order_acquire);
+        std::size_t n = 0;
+
+        ValueType value;
+        while (head.load(std::memory_order_relaxed) < end && pop(value)) {
+            func(std::as_const(value));
+            ++n;
+        }
+        return n;
+    }
+
+    std::size_t size() const noexcept {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        return t > h ? std::min(t - h, Capacity) : 0;
+    }
+
+    TraceStats stats() const noexcept {
+        return {dropped.load(std::memory_order_relaxed), overwritten.load(std::memory_order_relaxed)};
+    }
+
+private:
+    alignas(CacheLine) Slot buffer[Capacity];
+
+    // Producer's group
+    alignas(CacheLine) std::atomic<std::size_t> tail{0};
+    std::size_t head_cache{0}; // local, DropNewest only
+    std::atomic<uint64_t> dropped{0};
+
+    // Consumer's group
+    alignas(CacheLine) std::atomic<std::size_t> head{0};
+    std::atomic<uint64_t> overwritten{0};
+};
+
 template <typename KeyType, typename ValueType, std::size_t Capacity = 1024, std::size_t MaxThreads = 16>
 requires PowerOfTwoValue<MaxThreads>
 class Lv1_bdFlatLRU : private NonCopyableNonMoveable {
@@ -848,6 +1385,7 @@ private:
 
         // meta
         uint32_t   gen = 0;                     // 4 bytes // ABA protection
+        uint32_t   era = 0;                     // 4 bytes // Stale after clear() unless it matches the map one
         index_type next = NullIdx;              // 2 or 4 bytes
         index_type prev = NullIdx;              // 2 or 4 bytes
         slot_state state = slot_state::Empty;   // 1 byte
@@ -897,6 +1435,28 @@ private:
         current.prev = NullIdx;
     }
 
+    // Occupied slot of a previous era reads as Deleted
+    bool is_live(const Entry& current) const noexcept {
+        return current.state == slot_state::Occupied && current.era == _era;
+    }
+
+    // Tombstones followed by an Empty slot end no probe chain: they can be Empty again
+    void collapse_tombstones(std::size_t idx) noexcept {
+        if (_table[next_slot(idx)].state != slot_state::Empty) return;
+
+        for (std::size_t i = 0; i < TableSize && _table[idx].state == slot_state::Deleted; ++i) {
+            _table[idx].state = slot_state::Empty;
+            idx = (idx - 1) & Mask;
+        }
+    }
+
+    void reclaim_stale(std::size_t idx) {
+        _table[idx].value.~ValueType(); // Due to placement new
+        _table[idx].state = slot_state::Deleted;
+        _stale--;
+        collapse_tombstones(idx);
+    }
+
     void push_front(index_type idx) {
         auto& current = _table[idx];
         current.next = _head;
@@ -916,7 +1476,7 @@ public:
     }
 
     bool is_valid_gen(index_type idx, uint32_t gen) const noexcept {
-        return _table[idx].state == slot_state::Occupied && _table[idx].gen == gen;
+        return is_live(_table[idx]) && _table[idx].gen == gen;
     }
 
     std::size_t size() { return _size; }
@@ -927,7 +1487,7 @@ public:
         std::size_t idx = calculate_hash_idx(key);
         index_type first_del = NullIdx;
 
-        while (true) {
+        for (std::size_t i = 0; i < TableSize; ++i) {
             const auto& current = _table[idx];
 
             if (current.state == slot_state::Empty) {
@@ -935,28 +1495,35 @@ public:
                 return {nullptr, target, 0, false};
             }
 
-            if (current.state == slot_state::Deleted && first_del == NullIdx) {
+            if (is_live(current)) {
+                if (current.key == key) {
+                    return {const_cast<ValueType*>(&current.value), static_cast<index_type>(idx), current.gen, true};
+                }
+            } else if (first_del == NullIdx) { // Deleted or stale
                 first_del = static_cast<index_type>(idx);
             }
 
-            if (current.state == slot_state::Occupied && current.key == key) {
-                return {const_cast<ValueType*>(&current.value), static_cast<index_type>(idx), current.gen, true};
-            }
-
             idx = next_slot(idx);
         }
 
-        // It can loop for eternity only if Load Factor > 1.0 (all slots are Occupied or Deleted)
-        // But since it has Capacity * 2 and there is no deletion of Empty slots, this is impossible.
-        assert(false && "LinkedFlatMap table size overflow or corrupted logic");
-        __builtin_unreachable(); // I'm sure
+        // No Empty slot on the whole way: size is bounded by Capacity (TableSize / 2), so there is a free one
+        assert(first_del != NullIdx && "LinkedFlatMap table size overflow or corrupted logic");
+        return {nullptr, first_del, 0, false};
     }
 
     template <typename... Args>
     void emplace_at(index_type idx, const KeyType& key, Args&&... args) {
         auto& current = _table[idx];
+        if (current.state == slot_state::Occupied) { // Stale slot is reclaimed right here
+            current.value.~ValueType();
+            _stale--;
+        }
+
         current.key = key;
         current.gen++;
+        current.era = _era;
+        current.next = NullIdx;
+        current.prev = NullIdx;
 
         new (&current.value) value_type(std::forward<Args>(args)...); // Memory had been allocated by assign_slot
 
@@ -968,21 +1535,21 @@ public:
         std::size_t idx = calculate_hash_idx(key);
         index_type first_del_idx_wth_same_key = NullIdx;
 
-        while (true) {
+        for (std::size_t i = 0; i < TableSize; ++i) {
             if (_table[idx].state == slot_state::Empty) {
                 return (first_del_idx_wth_same_key != NullIdx) ? first_del_idx_wth_same_key
                                                                              : static_cast<index_type>(idx);
             }
 
-            if (_table[idx].state == slot_state::Deleted && first_del_idx_wth_same_key == NullIdx) {
+            if (!is_live(_table[idx]) && first_del_idx_wth_same_key == NullIdx) {
                 first_del_idx_wth_same_key = static_cast<index_type>(idx);
             }
 
             idx = next_slot(idx);
         }
 
-        assert(false && "LinkedFlatMap table size overflow or corrupted logic");
-        __builtin_unreachable(); // I'm sure
+        assert(first_del_idx_wth_same_key != NullIdx && "LinkedFlatMap table size overflow or corrupted logic");
+        return first_del_idx_wth_same_key;
     }
 
     void move_to_front(index_type idx) {
@@ -992,26 +1559,73 @@ public:
         if (curr.next != NullIdx) __builtin_prefetch(&_table[curr.next], 1, 3);
         if (curr.prev != NullIdx) __builtin_prefetch(&_table[curr.prev], 1, 3);
 
-        detach(idx);
-
+        // Fresh slot isn't linked yet: detach() would reset head & tail
+        if (curr.prev != NullIdx) detach(idx);
         push_front(idx);
     }
 
     void erase_index(const index_type& idx) {
-        if (idx == NullIdx || _table[idx].state != slot_state::Occupied) return;
+        if (idx == NullIdx || !is_live(_table[idx])) return;
 
         detach(idx);
 
         _table[idx].value.~ValueType(); // Due to placement new
         _table[idx].state = slot_state::Deleted;
         _size--;
+        collapse_tombstones(idx);
     }
 
-private:
-    std::unique_ptr<Entry[]> _table;
-    index_type _head = NullIdx;
-    index_type _tail = NullIdx;
+    // O(1): slots of the previous era read as Deleted, they're reclaimed on reuse or by sweep()
+    void clear() noexcept {
+        _stale += _size;
+        _size = 0;
+        _head = NullIdx;
+        _tail = NullIdx;
+        _era++;
+    }
+
+    // Reclaims stale slots among the next `budget` ones, amortized over writers
+    std::size_t sweep(std::size_t budget) {
+        std::size_t reclaimed = 0;
+
+        for (; budget > 0 && _stale > 0; --budget) {
+            const std::size_t idx = _sweep_cursor;
+            _sweep_cursor = next_slot(_sweep_cursor);
+
+            if (_table[idx].state == slot_state::Occupied && _table[idx].era != _era) {
+                reclaim_stale(idx);
+                reclaimed++;
+            }
+        }
+        return reclaimed;
+    }
+
+    static constexpr std::size_t slot_count() noexcept { return TableSize; }
+
+    // Erases live slots of [first, last) matching pred(key, value)
+    template <typename P>
+    std::size_t erase_if(std::size_t first, std::size_t last, P&& pred) {
+        std::size_t erased = 0;
+        last = std::min(last, TableSize);
+
+        for (std::size_t idx = first; idx < last; ++idx) {
+            const auto& current = _table[idx];
+            if (is_live(current) && pred(current.key, current.value)) {
+                erase_index(static_cast<index_type>(idx));
+                erased++;
+            }
+        }
+        return erased;
+    }
+
+private:
+    std::unique_ptr<Entry[]> _table;
+    index_type _head = NullIdx;
+    index_type _tail = NullIdx;
     std::size_t _size = 0;
+    std::size_t _stale = 0;
+    std::size_t _sweep_cursor = 0;
+    uint32_t    _era = 0;
 };
 
 //               Up to 16-32 cores
@@ -1034,6 +1648,8 @@ private:
     using SPSCBuffer = SPSC_RingBufferUltraFast<UpdateOp, Capacity / (4 * MaxThreads)>;
 
     static constexpr std::size_t CacheLine = sizes::CacheLine;
+    static constexpr std::size_t EraseChunk = 256;     // Slots per lock hold in erase_if()
+    static constexpr std::size_t SweepBudget = 8;      // Slots per put() to reclaim after clear()
     static_assert(std::has_single_bit(MaxThreads), "MaxThreads must be a power of 2!");
 
 private:
@@ -1096,14 +1712,10 @@ public:
         return *(res.ptr);
     }
 
+private:
+    // Under unique lock
     template <typename T>
-    void put(const KeyType& key, T&& value) {
-        std::unique_lock lock(_rw_mtx);
-
-        if (_dirty_mask.load(std::memory_order_relaxed)) {
-            apply_updates();
-        }
-
+    void commit_put(const KeyType& key, T&& value) {
         auto res = _collection.lookup(key);
 
         if (res.found) {
@@ -1124,6 +1736,73 @@ public:
         }
     }
 
+    template <typename Item>
+    void put_batch(std::span<const Item> items) {
+        std::unique_lock lock(_rw_mtx);
+
+        if (_dirty_mask.load(std::memory_order_relaxed)) {
+            apply_updates();
+        }
+
+        for (const auto& item : items) {
+            const auto& [key, value] = batch::deref(item);
+            commit_put(key, value);
+        }
+
+        _collection.sweep(SweepBudget * items.size());
+    }
+
+public:
+    template <typename T>
+    void put(const KeyType& key, T&& value) {
+        std::unique_lock lock(_rw_mtx);
+
+        if (_dirty_mask.load(std::memory_order_relaxed)) {
+            apply_updates();
+        }
+
+        commit_put(key, std::forward<T>(value));
+        _collection.sweep(SweepBudget);
+    }
+
+    // One lock hold for the whole batch, later items win
+    void put_many(std::span<const std::pair<KeyType, ValueType>> items) { put_batch(items); }
+    void put_many(std::span<const std::pair<KeyType, ValueType>* const> items) { put_batch(items); }
+
+    bool erase(const KeyType& key) {
+        std::unique_lock lock(_rw_mtx);
+
+        auto res = _collection.lookup(key);
+        if (!res.found) return false;
+
+        _collection.erase_index(res.idx);
+        return true;
+    }
+
+    // pred(const KeyType&, const ValueType&), the lock is released between chunks
+    template <typename P>
+    std::size_t erase_if(P&& pred) {
+        std::size_t erased = 0;
+
+        for (std::size_t first = 0; first < cacheMap::slot_count(); first += EraseChunk) {
+            std::unique_lock lock(_rw_mtx);
+            erased += _collection.erase_if(first, first + EraseChunk, pred);
+        }
+        return erased;
+    }
+
+    // O(1): old entries are reclaimed by later puts
+    void clear() {
+        std::unique_lock lock(_rw_mtx);
+        _collection.clear();
+    }
+
+    // Live entries, stale slots of a cleared era don't count
+    std::size_t size() {
+        std::shared_lock lock(_rw_mtx);
+        return _collection.size();
+    }
+
 private:
     alignas(CacheLine) PaddedSPSC               _update_buffers[MaxThreads];
     alignas(CacheLine) std::atomic<uint64_t>    _dirty_mask{0};
@@ -1153,6 +1832,7 @@ private:
         // Group 1: Metadata (Hot)
         std::atomic<uint32_t> gen{0};                       // 4 bytes
         std::atomic<slot_state> state{slot_state::Empty};   // 1 byte (padded to 4 by compiler)
+        std::atomic<uint32_t> era{0};                       // 4 bytes, stale after clear() unless it matches
 
         // Group 2: Search (Hot)
         key_type key;                                       // 8 bytes
@@ -1214,6 +1894,38 @@ private:
         current.prev = NullIdx;
     }
 
+    // Occupied slot of a previous era reads as Deleted
+    bool is_live(const Entry& current) const noexcept {
+        return current.state.load(std::memory_order_relaxed) == slot_state::Occupied &&
+               current.era.load(std::memory_order_relaxed) == _era.load(std::memory_order_relaxed);
+    }
+
+    // Tombstones followed by an Empty slot end no probe chain: they can be Empty again
+    void collapse_tombstones(std::size_t idx) noexcept {
+        if (_table[next_slot(idx)].state.load(std::memory_order_relaxed) != slot_state::Empty) return;
+
+        for (std::size_t i = 0; i < TableSize; ++i) {
+            auto& current = _table[idx];
+            if (current.state.load(std::memory_order_relaxed) != slot_state::Deleted) break;
+
+            current.state.store(slot_state::Empty, std::memory_order_release);
+            idx = (idx - 1) & Mask;
+        }
+    }
+
+    // Seqlock write: readers don't trust the slot while gen is odd
+    void destroy_slot(std::size_t idx) noexcept {
+        auto& current = _table[idx];
+        current.gen.fetch_add(1, std::memory_order_release);
+
+        current.value.~ValueType(); // Due to placement new
+        current.state.store(slot_state::Deleted, std::memory_order_relaxed);
+
+        current.gen.fetch_add(1, std::memory_order_release);
+        current.gen.notify_all();
+        collapse_tombstones(idx);
+    }
+
     void push_front(index_type idx) noexcept {
         auto& current = _table[idx];
         current.next = _head;
@@ -1233,7 +1945,7 @@ public:
     }
 
     bool is_valid_gen(index_type idx, uint32_t gen) const noexcept {
-        return _table[idx].state == slot_state::Occupied && _table[idx].gen == gen;
+        return is_live(_table[idx]) && _table[idx].gen == gen;
     }
 
     std::size_t size() const noexcept { return _size; }
@@ -1244,7 +1956,7 @@ public:
         std::size_t idx = calculate_hash_idx(key);
         index_type first_del = NullIdx;
 
-        while (true) {
+        for (std::size_t i = 0; i < TableSize; ++i) {
             const auto& current = _table[idx];
 
             if (current.state == slot_state::Empty) {
@@ -1252,21 +1964,20 @@ public:
                 return {nullptr, target, 0, false};
             }
 
-            if (current.state == slot_state::Deleted && first_del == NullIdx) {
+            if (is_live(current)) {
+                if (current.key == key) {
+                    return {const_cast<ValueType*>(&current.value), static_cast<index_type>(idx), current.gen, true};
+                }
+            } else if (first_del == NullIdx) { // Deleted or stale
                 first_del = static_cast<index_type>(idx);
             }
 
-            if (current.state == slot_state::Occupied && current.key == key) {
-                return {const_cast<ValueType*>(&current.value), static_cast<index_type>(idx), current.gen, true};
-            }
-
             idx = next_slot(idx);
         }
 
-        // It can loop for eternity only if Load Factor > 1.0 (all slots are Occupied or Deleted)
-        // But since it has Capacity * 2 and there is no deletion of Empty slots, this is impossible.
-        assert(false && "LinkedFlatMap table size overflow or corrupted logic");
-        __builtin_unreachable(); // I'm sure
+        // No Empty slot on the whole way: size is bounded by Capacity (TableSize / 2), so there is a free one
+        assert(first_del != NullIdx && "LinkedFlatMap table size overflow or corrupted logic");
+        return {nullptr, first_del, 0, false};
     }
 /*
     LookupResult get_lockless(const KeyType& key) const noexcept {
@@ -1314,8 +2025,16 @@ public:
 
         auto& current = _table[idx];
         current.gen.fetch_add(1, std::memory_order_release);    // This is important to avoid dirty read
+        if (current.state.load(std::memory_order_relaxed) == slot_state::Occupied) { // Stale slot is reclaimed here
+            current.value.~ValueType();
+            _stale--;
+        }
+
         std::atomic_ref<key_type> key_ref(current.key);
         key_ref.store(key, std::memory_order_relaxed);          // Data race avoidance
+        current.era.store(_era.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        current.next = NullIdx;
+        current.prev = NullIdx;
 
         new (&current.value) value_type(std::forward<Args>(args)...); // Memory had been allocated by assign_slot
 
@@ -1329,21 +2048,21 @@ public:
         std::size_t idx = calculate_hash_idx(key);
         index_type first_del_idx_wth_same_key = NullIdx;
 
-        while (true) {
+        for (std::size_t i = 0; i < TableSize; ++i) {
             if (_table[idx].state == slot_state::Empty) {
                 return (first_del_idx_wth_same_key != NullIdx) ? first_del_idx_wth_same_key
                                                                              : static_cast<index_type>(idx);
             }
 
-            if (_table[idx].state == slot_state::Deleted && first_del_idx_wth_same_key == NullIdx) {
+            if (!is_live(_table[idx]) && first_del_idx_wth_same_key == NullIdx) {
                 first_del_idx_wth_same_key = static_cast<index_type>(idx);
             }
 
             idx = next_slot(idx);
         }
 
-        assert(false && "LinkedFlatMap table size overflow or corrupted logic");
-        __builtin_unreachable(); // I'm sure
+        assert(first_del_idx_wth_same_key != NullIdx && "LinkedFlatMap table size overflow or corrupted logic");
+        return first_del_idx_wth_same_key;
     }
 
     void move_to_front(index_type idx) noexcept {
@@ -1353,27 +2072,74 @@ public:
         if (curr.next != NullIdx) __builtin_prefetch(&_table[curr.next], 1, 3);
         if (curr.prev != NullIdx) __builtin_prefetch(&_table[curr.prev], 1, 3);
 
-        detach(idx);
-
+        // Fresh slot isn't linked yet: detach() would reset head & tail
+        if (curr.prev != NullIdx) detach(idx);
         push_front(idx);
     }
 
     void erase_index(const index_type& idx) noexcept {
-        if (idx == NullIdx || _table[idx].state != slot_state::Occupied) return;
+        if (idx == NullIdx || !is_live(_table[idx])) return;
 
         detach(idx);
-
-        _table[idx].value.~ValueType(); // Due to placement new
-        _table[idx].state = slot_state::Deleted;
-        _table[idx].gen++;
+        destroy_slot(idx);
         _size--;
     }
 
+    // O(1): slots of the previous era read as Deleted, they're reclaimed on reuse or by sweep()
+    void clear() noexcept {
+        _stale += _size;
+        _size = 0;
+        _head = NullIdx;
+        _tail = NullIdx;
+        _era.fetch_add(1, std::memory_order_release);
+    }
+
+    // Reclaims stale slots among the next `budget` ones, amortized over writers
+    std::size_t sweep(std::size_t budget) noexcept {
+        std::size_t reclaimed = 0;
+        const uint32_t era = _era.load(std::memory_order_relaxed);
+
+        for (; budget > 0 && _stale > 0; --budget) {
+            const std::size_t idx = _sweep_cursor;
+            _sweep_cursor = next_slot(_sweep_cursor);
+
+            const auto& current = _table[idx];
+            if (current.state.load(std::memory_order_relaxed) == slot_state::Occupied &&
+                current.era.load(std::memory_order_relaxed) != era) {
+                destroy_slot(idx);
+                _stale--;
+                reclaimed++;
+            }
+        }
+        return reclaimed;
+    }
+
+    static constexpr std::size_t slot_count() noexcept { return TableSize; }
+
+    // Erases live slots of [first, last) matching pred(key, value)
+    template <typename P>
+    std::size_t erase_if(std::size_t first, std::size_t last, P&& pred) {
+        std::size_t erased = 0;
+        last = std::min(last, TableSize);
+
+        for (std::size_t idx = first; idx < last; ++idx) {
+            const auto& current = _table[idx];
+            if (is_live(current) && pred(current.key, current.value)) {
+                erase_index(static_cast<index_type>(idx));
+                erased++;
+            }
+        }
+        return erased;
+    }
+
 private:
     std::unique_ptr<Entry[]> _table;
     index_type _head = NullIdx;
     index_type _tail = NullIdx;
     std::size_t _size = 0;
+    std::size_t _stale = 0;
+    std::size_t _sweep_cursor = 0;
+    std::atomic<uint32_t> _era{0};
 };
 
 /*              Up to 32 cores
@@ -1383,7 +2149,8 @@ private:
 *   TODO:                       lock-free get()
 *   TODO:                       unique_lock for Writer
 */
-template <Hashable KeyType, typename ValueType, std::size_t Capacity = 4 * 1024, std::size_t MaxThreads = 32>
+template <Hashable KeyType, typename ValueType, std::size_t Capacity = 4 * 1024, std::size_t MaxThreads = 32,
+          typename Lock = HybridLock<>>
 requires PowerOfTwoValue<MaxThreads>
 class Lv4_bdFlatLRU : private NonCopyableNonMoveable {
 public:
@@ -1402,6 +2169,8 @@ private:
     using SPSCBuffer = SPSC_RingBufferUltraFast<UpdateOp, Capacity / (4 * MaxThreads)>;
 
     static constexpr std::size_t CacheLine = sizes::CacheLine;
+    static constexpr std::size_t EraseChunk = 256;     // Slots per lock hold in erase_if()
+    static constexpr std::size_t SweepBudget = 8;      // Slots per put() to reclaim after clear()
     static_assert(std::has_single_bit(MaxThreads), "MaxThreads must be a power of 2!");
 
 private:
@@ -1465,22 +2234,10 @@ public:
         return *(res.ptr);
     }
 
+private:
+    // Under lock
     template <typename T>
-    void put(const KeyType& key, T&& value) {
-
-        //CRITICAL  ****    Potential problem if user calls yield
-        //NOTE      ****    Use mutex, instead of spin
-        //std::lock_guard<std::mutex> lock(_mtx);
-        while (_spin_lock.test_and_set(std::memory_order_acquire)) {
-            __builtin_ia32_pause();
-        }
-
-        auto release_lock = [this]() { _spin_lock.clear(std::memory_order_release); };
-
-        if (_dirty_mask.load(std::memory_order_relaxed)) {
-            apply_updates();
-        }
-
+    void commit_put(const KeyType& key, T&& value) {
         auto res = _collection.lookup(key);
 
         if (res.found) {
@@ -1488,7 +2245,6 @@ public:
 
             if (entry.value == value) [[unlikely]] { // Cache & care
                 _collection.move_to_front(res.idx);
-                release_lock();
                 return; // Quiet update
             }
 
@@ -1508,20 +2264,92 @@ public:
             _collection.emplace_at(res.idx, key, std::forward<T>(value));
             _collection.move_to_front(res.idx);
         }
+    }
+
+    template <typename Item>
+    void put_batch(std::span<const Item> items) {
+        _lock.lock();
+
+        if (_dirty_mask.load(std::memory_order_relaxed)) {
+            apply_updates();
+        }
+
+        for (const auto& item : items) {
+            const auto& [key, value] = batch::deref(item);
+            commit_put(key, value);
+        }
+
+        _collection.sweep(SweepBudget * items.size());
+        _lock.unlock();
+    }
+
+public:
+    template <typename T>
+    void put(const KeyType& key, T&& value) {
+        _lock.lock();
+
+        if (_dirty_mask.load(std::memory_order_relaxed)) {
+            apply_updates();
+        }
+
+        commit_put(key, std::forward<T>(value));
+
+        _collection.sweep(SweepBudget);
+        _lock.unlock();
+    }
+
+    // One lock hold for the whole batch, later items win
+    void put_many(std::span<const std::pair<KeyType, ValueType>> items) { put_batch(items); }
+    void put_many(std::span<const std::pair<KeyType, ValueType>* const> items) { put_batch(items); }
+
+    bool erase(const KeyType& key) {
+        _lock.lock();
+
+        auto res = _collection.lookup(key);
+        if (res.found) {
+            _collection.erase_index(res.idx);
+        }
+
+        _lock.unlock();
+        return res.found;
+    }
+
+    // pred(const KeyType&, const ValueType&), the lock is released between chunks
+    template <typename P>
+    std::size_t erase_if(P&& pred) {
+        std::size_t erased = 0;
+
+        for (std::size_t first = 0; first < cacheMap::slot_count(); first += EraseChunk) {
+            _lock.lock();
+            erased += _collection.erase_if(first, first + EraseChunk, pred);
+            _lock.unlock();
+        }
+        return erased;
+    }
+
+    // O(1): old entries are reclaimed by later puts
+    void clear() noexcept {
+        _lock.lock();
+        _collection.clear();
+        _lock.unlock();
+    }
 
-        release_lock();
+    // Live entries, stale slots of a cleared era don't count
+    std::size_t size() {
+        _lock.lock();
+            const std::size_t n = _collection.size();
+        _lock.unlock();
+        return n;
     }
 
+    LockStats lock_stats() const noexcept requires CountingLock<Lock> { return _lock.stats(); }
+
 private:
     alignas(CacheLine) PaddedSPSC               _update_buffers[MaxThreads];
     alignas(CacheLine) std::atomic<uint64_t>    _dirty_mask{0};
 
     cacheMap            _collection;
-    //std::mutex          _mtx;
-
-    //CRITICAL  ****    Potential problem if user calls yield
-    //NOTE      ****    Use mutex, instead of spin
-    std::atomic_flag    _spin_lock = ATOMIC_FLAG_INIT;
+    Lock                _lock;      // Writers only, readers go through the SPSC buffers
 };
 
 //  Wrapper for SharedLRU
@@ -1572,6 +2400,34 @@ public:
         _shards[get_shard_idx(key)].cache->put(key, std::forward<T>(value));
     }
 
+    // Grouped by shard: one lock hold (and one epoch bump) per touched shard
+    void put_many(std::span<const std::pair<KeyType, ValueType>> items) {
+        std::array<std::vector<const std::pair<KeyType, ValueType>*>, ShardsCount> groups;
+        for (const auto& item : items) {
+            groups[get_shard_idx(item.first)].push_back(&item);
+        }
+
+        for (std::size_t i = 0; i < ShardsCount; ++i) {
+            if (groups[i].empty()) continue;
+            _shards[i].cache->put_many(std::span<const std::pair<KeyType, ValueType>* const>(groups[i]));
+        }
+    }
+
+    bool erase(const KeyType& key) {
+        return _shards[get_shard_idx(key)].cache->erase(key);
+    }
+
+    template <typename P>
+    std::size_t erase_if(P&& pred) {
+        std::size_t erased = 0;
+        for (auto& shard : _shards) erased += shard.cache->erase_if(pred);
+        return erased;
+    }
+
+    void clear() {
+        for (auto& shard : _shards) shard.cache->clear();
+    }
+
 private:
     struct alignas(CacheLine) ShardWrapper {
         std::unique_ptr<Cache> cache;
@@ -1652,12 +2508,14 @@ struct HugePagesAllocator {
             if (head) return reinterpret_cast<T*>(head);
         }
 
-        size_t bytes = n * sizeof(T);
+        // Cache line granularity keeps every block aligned for over-aligned entries
+        static_assert(alignof(T) <= sizes::CacheLine);
+        size_t bytes = sizes::align_up(n * sizeof(T));
         size_t current_offset = arena.offset.fetch_add(bytes, std::memory_order_relaxed);
 
         if (!arena.ptr || current_offset + bytes > arena.capacity) [[unlikely]] {
             // If Huge Pages are out of space or not supported: malloc
-            void* fallback = std::malloc(bytes);
+            void* fallback = std::aligned_alloc(sizes::CacheLine, bytes);
             if (!fallback) throw std::bad_alloc();
             return static_cast<T*>(fallback);
         }
@@ -1716,107 +2574,559 @@ public:
     }
 };
 
-template <Hashable KeyType, typename ValueType, std::size_t Capacity = 1024, typename Alloc = HugePagesAllocator<char>>
-requires PowerOfTwoValue<Capacity>
-class Lv3_LinkedFlatMap : private NonCopyableNonMoveable { // Open Addressing table with Linear Probing
-public:
-    using index_type = std::conditional_t<(Capacity <= 65535), uint16_t, uint32_t>;
-    static constexpr index_type NullIdx = std::numeric_limits<index_type>::max();
-    static constexpr std::size_t CacheLine = sizes::CacheLine;
+/*  Key storage of Lv3_LinkedFlatMap slots
+*   InlineKey:  trivially copyable key right in the slot
+*   ArenaKey:   std::string, short keys inline, long ones in a per-map KeyArena
+*               hash fingerprint rejects most mismatches before any byte compare
+*   Lockless readers may see a torn key, it's rejected by the slot gen as a torn value is
+*/
+struct NoKeyArena {};
 
-    enum class slot_state : uint8_t { Empty = 0, Occupied = 1, Deleted = 2 };
+template <typename KeyType>
+struct InlineKey {
+    static_assert(std::is_trivially_copyable_v<KeyType>, "Use ArenaKey-like storage for this KeyType");
+    using arena_type = NoKeyArena;
 
-    static constexpr const char* name() noexcept { return "Lv3_LinkedFlatMap"; }
-    using value_type = ValueType;
-    using key_type = KeyType;
-    using value_ptr = std::shared_ptr<ValueType>;
+    KeyType key;
 
-private:
+    template <typename K>
+    bool matches(const K& lookup, std::size_t /*hash*/) const noexcept {
+        return typename key_traits<KeyType>::key_equal{}(load(), lookup);
+    }
 
-    struct alignas(CacheLine / 2) MetaEntry {
-        // Group 1: Metadata (Hot)                          8 bytes
-        std::atomic<uint32_t>  gen{0};
-        std::atomic<slot_state> state{slot_state::Empty};
+    KeyType load() const noexcept {
+        std::atomic_ref<const KeyType> key_ref(key);
+        return key_ref.load(std::memory_order_relaxed);
+    }
 
-        // Group 2: Search (Hot)                            8 bytes
-        KeyType key;
+    [[nodiscard]] static bool reserve(const KeyType&, arena_type&) noexcept { return true; }
 
-        // Group 3: LRU Links (Warm)                        8 bytes
-        index_type next = NullIdx;
-        index_type prev = NullIdx;
-    };
+    void store(const KeyType& new_key, std::size_t /*hash*/, arena_type&) noexcept {
+        std::atomic_ref<KeyType> key_ref(key);
+        key_ref.store(new_key, std::memory_order_relaxed);      // Data race avoidance
+    }
 
-    struct DataEntry {
-        // exGroup 4: Data (Cold/Warm)
-        value_ptr value;                                    // sizeof(value_type)
-    };
+    void release(arena_type&) noexcept {}
+};
 
-public:
-    const MetaEntry& get_meta(index_type idx) const noexcept {
-        return _meta_table[idx];
+// Blocks are recycled by size class and never returned while the map lives:
+// a lockless reader holding a stale block reads garbage at worst, never unmapped memory
+// Nothing throws: free lists & the chunk list are intrusive, reserve() reports a failed malloc,
+// so the writer reserves before it mutates and allocate() only pops what was reserved
+class KeyArena : private NonCopyableNonMoveable {
+    static constexpr std::size_t MinBlockShift = 6;                 // 64 bytes
+    static constexpr std::size_t Classes = 20;                      // up to 32 MiB
+    static constexpr std::size_t ChunkSize = 64 * sizes::KiB;
+
+    static std::size_t class_of(std::size_t block_bytes) noexcept {
+        return std::max<std::size_t>(std::bit_width(block_bytes - 1), MinBlockShift) - MinBlockShift;
     }
 
-    MetaEntry& get_meta_mutable(index_type idx) noexcept {
-        return _meta_table[idx];
+    static std::size_t class_of_key(std::size_t bytes) noexcept {
+        return class_of(sizes::align_up<sizeof(uint64_t)>(bytes) + sizeof(uint64_t));
     }
 
-    const DataEntry& get_data(index_type idx) const noexcept {
-        return _data_table[idx];
+    // Chunk: [next chunk][blocks...]
+    std::byte* new_chunk(std::size_t bytes) noexcept {
+        void* mem = std::malloc(sizeof(void*) + bytes);
+        if (!mem) return nullptr;
+        *static_cast<void**>(mem) = _chunks;
+        _chunks = mem;
+        return static_cast<std::byte*>(mem) + sizeof(void*);
     }
 
-    DataEntry& get_data_mutable(index_type idx) noexcept {
-        return _data_table[idx];
+    // Free block: [capacity][next free block], a stale reader may see the link word
+    void push_free(std::size_t cls, uint64_t* block) noexcept {
+        std::atomic_ref<uint64_t>(block[1]).store(reinterpret_cast<uintptr_t>(_free[cls]), std::memory_order_relaxed);
+        _free[cls] = block;
     }
 
-private:
-    static_assert(std::has_single_bit(Capacity), "Capacity must be power of 2");
-    static constexpr std::size_t TableSize = Capacity * 2; // Load factor 0.5
-    static_assert(TableSize == Capacity * 2, "Load factor must be 0.5");
-    static constexpr std::size_t Mask = TableSize - 1;
-    using MetaAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<MetaEntry>;
-    using DataAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<DataEntry>;
-private:
+public:
+    KeyArena() = default;
+    ~KeyArena() {
+        while (_chunks) {
+            void* next = *static_cast<void**>(_chunks);
+            std::free(_chunks);
+            _chunks = next;
+        }
+    }
 
-    struct LookupResult {
-        value_ptr  ptr;
-        index_type idx;
-        uint32_t   gen;
-    };
+    // Makes the next allocate(bytes) infallible, false when out of memory
+    [[nodiscard]] bool reserve(std::size_t bytes) noexcept {
+        const std::size_t cls = class_of_key(bytes);
+        assert(cls < Classes && "Key is too long for KeyArena");
+        if (_free[cls]) return true;
+
+        const std::size_t block_bytes = std::size_t{1} << (cls + MinBlockShift);
+        std::byte* mem;
+        if (block_bytes > ChunkSize) [[unlikely]] {
+            mem = new_chunk(block_bytes);
+            if (!mem) return false;
+        } else {
+            if (_left < block_bytes) {
+                std::byte* chunk = new_chunk(ChunkSize);
+                if (!chunk) return false;
+                _cursor = chunk;
+                _left = ChunkSize;
+            }
+            mem = _cursor;
+            _cursor += block_bytes;
+            _left -= block_bytes;
+        }
 
-    std::size_t calculate_hash_idx(const KeyType& key) const noexcept {
-        return std::hash<KeyType>{}(key) & Mask;
+        auto* block = reinterpret_cast<uint64_t*>(mem);
+        std::atomic_ref<uint64_t>(block[0]).store(block_bytes / sizeof(uint64_t) - 1, std::memory_order_relaxed);
+        push_free(cls, block);
+        return true;
     }
 
-    std::size_t next_slot(std::size_t current_idx) const noexcept {
-        return (current_idx + 1) & Mask;
+    // Block: [payload capacity in words][payload words...], capacity never changes
+    uint64_t* allocate(std::size_t bytes) noexcept {
+        const std::size_t cls = class_of_key(bytes);
+        uint64_t* block = _free[cls];
+        assert(block && "KeyArena::allocate without a reserve");
+
+        _free[cls] = reinterpret_cast<uint64_t*>(static_cast<uintptr_t>(block[1]));
+        return block;
     }
 
-    void detach(const index_type& idx) noexcept {
-        auto& meta = _meta_table[idx];
-        const index_type n = meta.next;
-        const index_type p = meta.prev;
+    void deallocate(uint64_t* block) noexcept {
+        push_free(class_of((block[0] + 1) * sizeof(uint64_t)), block);
+    }
 
-        if (n != NullIdx) [[likely]] { _meta_table[n].prev = p; }
-        else _tail = p;
+private:
+    std::array<uint64_t*, Classes>  _free = {};
+    void*                           _chunks = nullptr;
+    std::byte*                      _cursor = nullptr;
+    std::size_t                     _left = 0;
+};
+
+struct ArenaKey {
+    using arena_type = KeyArena;
+    static constexpr std::size_t InlineWords = 4;
+    static constexpr std::size_t InlineBytes = InlineWords * sizeof(uint64_t); // MetaEntry stays in one cache line
+
+    uint32_t    fingerprint = 0;
+    uint32_t    length = 0;
+    uint64_t*   far = nullptr;                  // KeyArena block, keys longer than InlineBytes
+    uint64_t    near[InlineWords] = {};
+
+private:
+    template <typename T>
+    static T load_word(const T& word, std::memory_order order = std::memory_order_relaxed) noexcept {
+        return std::atomic_ref<T>(const_cast<T&>(word)).load(order);
+    }
+
+    template <typename T>
+    static void store_word(T& word, T value, std::memory_order order = std::memory_order_relaxed) noexcept {
+        std::atomic_ref<T>(word).store(value, order);
+    }
+
+    static uint32_t fingerprint_of(std::size_t hash) noexcept {
+        return static_cast<uint32_t>(hash >> 32); // Low bits are spent on the slot index
+    }
+
+    static uint64_t pack(std::string_view key, std::size_t word) noexcept {
+        uint64_t value = 0;
+        const std::size_t offset = word * sizeof(uint64_t);
+        std::memcpy(&value, key.data() + offset, std::min(sizeof(uint64_t), key.size() - offset));
+        return value;
+    }
+
+    // Payload words & their capacity: block pointer is published with release after its header
+    std::pair<const uint64_t*, std::size_t> words(std::size_t len) const noexcept {
+        if (len <= InlineBytes) return {near, InlineWords};
+
+        const uint64_t* block = load_word(far, std::memory_order_acquire);
+        if (!block) return {nullptr, 0};
+        return {block + 1, load_word(block[0])};
+    }
+
+public:
+    template <typename K>
+    bool matches(const K& lookup, std::size_t hash) const noexcept {
+        const std::string_view view = strings::as_view(lookup);
+
+        if (load_word(fingerprint) != fingerprint_of(hash)) return false;
+        if (load_word(length) != view.size()) return false;
+
+        const auto [payload, capacity] = words(view.size());
+        const std::size_t n = (view.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        if (n > capacity) return false;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            if (load_word(payload[i]) != pack(view, i)) return false;
+        }
+        return true;
+    }
+
+    std::string load() const {
+        const std::size_t len = load_word(length);
+        const auto [payload, capacity] = words(len);
+
+        std::string key(std::min(len, capacity * sizeof(uint64_t)), '\0');
+        for (std::size_t offset = 0, i = 0; offset < key.size(); offset += sizeof(uint64_t), ++i) {
+            const uint64_t word = load_word(payload[i]);
+            std::memcpy(key.data() + offset, &word, std::min(sizeof(uint64_t), key.size() - offset));
+        }
+        return key;
+    }
+
+    // Arena space for store(key), false when out of memory
+    [[nodiscard]] static bool reserve(std::string_view key, KeyArena& arena) noexcept {
+        return key.size() <= InlineBytes || arena.reserve(key.size());
+    }
+
+    void store(std::string_view key, std::size_t hash, KeyArena& arena) noexcept {
+        release(arena);
+
+        store_word(fingerprint, fingerprint_of(hash));
+        store_word(length, static_cast<uint32_t>(key.size()));
+
+        const std::size_t n = (key.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        uint64_t* payload = near;
+        uint64_t* block = nullptr;
+
+        if (key.size() > InlineBytes) {
+            block = arena.allocate(key.size());
+            payload = block + 1;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) store_word(payload[i], pack(key, i));
+        if (block) store_word(far, block, std::memory_order_release);
+    }
+
+    void release(KeyArena& arena) noexcept {
+        if (!far) return;
+        arena.deallocate(far);
+        store_word(far, static_cast<uint64_t*>(nullptr));
+    }
+};
+
+template <typename KeyType>
+struct key_storage { using type = InlineKey<KeyType>; };
+
+template <>
+struct key_storage<std::string> { using type = ArenaKey; };
+
+/*  ARC ghost lists B1 & B2: fingerprints of recently evicted keys, no keys and no values
+*   Bucketed & lossy: 8 tags + 8 insertion numbers per cache line, a full bucket forgets its oldest entry
+*   A list is FIFO, an entry is alive while fewer than `bound` newer ones went to its list
+*/
+template <std::size_t Capacity>
+class GhostTable : private NonCopyableNonMoveable {
+    static constexpr std::size_t Ways = 8;
+    static constexpr std::size_t Buckets = std::max<std::size_t>(1, 2 * Capacity / Ways);
+    static_assert(std::has_single_bit(Buckets), "Buckets must be power of 2");
+
+    struct alignas(sizes::CacheLine) Bucket {
+        uint32_t tag[Ways]{};       // Fingerprint | list, 0 is empty
+        uint32_t seq[Ways]{};
+    };
+
+    // std::hash of an integer is the identity: no high bits for the tag without a mix
+    static uint64_t mix(std::size_t hash) noexcept {
+        uint64_t h = hash;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static uint32_t make_tag(uint64_t mixed, uint32_t list) noexcept {
+        return ((static_cast<uint32_t>(mixed >> 32) | 2u) & ~1u) | list;
+    }
+
+    bool alive(uint32_t tag, uint32_t seq, const std::array<std::size_t, 2>& bounds) const noexcept {
+        const uint32_t list = tag & 1u;
+        return tag != 0 && _inserted[list] - seq < bounds[list];
+    }
+
+public:
+    enum class Hit : uint8_t { None, B1, B2 };
+
+    void insert(std::size_t hash, uint32_t list, const std::array<std::size_t, 2>& bounds) noexcept {
+        const uint64_t mixed = mix(hash);
+        auto& bucket = _buckets[mixed & (Buckets - 1)];
+        std::size_t way = 0;
+        uint32_t oldest_age = 0;
+
+        for (std::size_t i = 0; i < Ways; ++i) {
+            if (!alive(bucket.tag[i], bucket.seq[i], bounds)) { way = i; break; }
+
+            const uint32_t age = _inserted[bucket.tag[i] & 1u] - bucket.seq[i];
+            if (age > oldest_age) { oldest_age = age; way = i; }
+        }
+
+        bucket.tag[way] = make_tag(mixed, list);
+        bucket.seq[way] = ++_inserted[list];
+        _live[list] = std::min(_live[list] + 1, bounds[list]);
+    }
+
+    // A found entry leaves its list
+    Hit take(std::size_t hash, const std::array<std::size_t, 2>& bounds) noexcept {
+        const uint64_t mixed = mix(hash);
+        auto& bucket = _buckets[mixed & (Buckets - 1)];
+
+        for (uint32_t list = 0; list < 2; ++list) {
+            const uint32_t tag = make_tag(mixed, list);
+            for (std::size_t i = 0; i < Ways; ++i) {
+                if (bucket.tag[i] == tag && alive(tag, bucket.seq[i], bounds)) {
+                    bucket.tag[i] = 0;
+                    if (_live[list] > 0) _live[list]--;
+                    return list == 0 ? Hit::B1 : Hit::B2;
+                }
+            }
+        }
+        return Hit::None;
+    }
+
+    // Approximate: entries aged out by the bound are counted out lazily
+    std::size_t size(uint32_t list, std::size_t bound) const noexcept {
+        return std::min(_live[list], bound);
+    }
+
+    void clear() noexcept {
+        std::fill(_buckets.begin(), _buckets.end(), Bucket{});
+        _inserted = {};
+        _live = {};
+    }
+
+private:
+    std::vector<Bucket>             _buckets = std::vector<Bucket>(Buckets);
+    std::array<uint32_t, 2>         _inserted{};
+    std::array<std::size_t, 2>      _live{};
+};
+
+/*  Who leaves a full map
+*   LRU:    the tail
+*   GDSF:   GreedyDual-Size-Frequency, the lowest priority = clock + hits * cost among a few slots near the tail
+*           clock is the priority of the last victim: entries that aren't hit age out, expensive ones slower
+*           No heap: sampling near the tail keeps eviction O(1) and hits a plain list splice
+*   ARC:    Adaptive Replacement Cache, T1 (seen once) & T2 (seen again) lists, the T1 target size
+*           follows the hits in the ghost lists B1 & B2: recency-heavy phases grow T1, frequency-heavy ones T2
+*   SLRU:   Segmented LRU, inserts land in probation (T1), a second hit promotes to protected (T2)
+*           Protected overflow goes back to the probation head: a one-time scan never reaches protected
+*/
+enum class EvictionPolicy : uint8_t { LRU, GDSF, ARC, SLRU };
+
+template <Hashable KeyType, typename ValueType, std::size_t Capacity = 1024,
+          EvictionPolicy Policy = EvictionPolicy::LRU, typename Alloc = HugePagesAllocator<char>>
+requires PowerOfTwoValue<Capacity>
+class Lv3_LinkedFlatMap : private NonCopyableNonMoveable { // Open Addressing table with Linear Probing
+public:
+    using index_type = std::conditional_t<(Capacity <= 65535), uint16_t, uint32_t>;
+    static constexpr index_type NullIdx = std::numeric_limits<index_type>::max();
+    static constexpr std::size_t CacheLine = sizes::CacheLine;
+
+    enum class slot_state : uint8_t { Empty = 0, Occupied = 1, Deleted = 2 };
+
+    static constexpr const char* name() noexcept { return "Lv3_LinkedFlatMap"; }
+    using value_type = ValueType;
+    using key_type = KeyType;
+    using value_ptr = std::shared_ptr<ValueType>;
+    using key_slot = typename key_storage<KeyType>::type;
+
+    // Policy input of an insert: admit() makes it before the victim is chosen
+    struct Admission {
+        float cost = 1.0f;
+        typename GhostTable<Capacity>::Hit ghost = GhostTable<Capacity>::Hit::None;
+    };
+
+private:
+    struct NoPolicySlot {};
+
+    struct GdsfSlot {
+        float    priority = 0;
+        float    cost = 1.0f;
+        uint32_t hits = 0;
+    };
+
+    using policy_slot = std::conditional_t<Policy == EvictionPolicy::GDSF, GdsfSlot, NoPolicySlot>;
+
+    static constexpr std::size_t GdsfSample = 8;           // Slots near the tail compared by victim()
+    static constexpr float GdsfRebaseAt = 1 << 22;         // Float keeps ~1.0 resolution up to 2^24
+
+    // Every list has its head & tail, a slot knows its list
+    static constexpr std::size_t Lists = (Policy == EvictionPolicy::ARC || Policy == EvictionPolicy::SLRU) ? 2 : 1;
+    static constexpr uint8_t T1 = 0;                        // SLRU: probation
+    static constexpr uint8_t T2 = Lists - 1;                // Hits go here, LRU & GDSF: the only list. SLRU: protected
+    static constexpr double DefaultProtectedShare = 0.8;
+
+    struct NoGhosts {};
+    using ghost_table = std::conditional_t<Policy == EvictionPolicy::ARC, GhostTable<Capacity>, NoGhosts>;
+    using GhostHit = typename GhostTable<Capacity>::Hit;
+
+    struct alignas(CacheLine / 2) MetaEntry {
+        // Group 1: Metadata (Hot)                          12 bytes
+        std::atomic<uint32_t>  gen{0};
+        std::atomic<slot_state> state{slot_state::Empty};
+        uint8_t                list = 0;                    // Writer only
+        std::atomic<uint32_t>  era{0};                      // Stale after clear() unless it matches
+
+        // Group 2: Search (Hot)                            8 bytes (48 bytes for ArenaKey)
+        key_slot key;
+
+        // Group 3: LRU Links (Warm)                        8 bytes
+        index_type next = NullIdx;
+        index_type prev = NullIdx;
+
+        // Group 4: Eviction (Warm)                         12 bytes for GDSF, none for LRU
+        [[no_unique_address]] policy_slot policy;
+    };
+
+    struct DataEntry {
+        // exGroup 5: Data (Cold/Warm)
+        value_ptr value;                                    // sizeof(value_type)
+    };
+
+public:
+    const MetaEntry& get_meta(index_type idx) const noexcept {
+        return _meta_table[idx];
+    }
+
+    MetaEntry& get_meta_mutable(index_type idx) noexcept {
+        return _meta_table[idx];
+    }
+
+    const DataEntry& get_data(index_type idx) const noexcept {
+        return _data_table[idx];
+    }
+
+    DataEntry& get_data_mutable(index_type idx) noexcept {
+        return _data_table[idx];
+    }
+
+private:
+    static_assert(std::has_single_bit(Capacity), "Capacity must be power of 2");
+    static constexpr std::size_t TableSize = Capacity * 2; // Load factor 0.5
+    static_assert(TableSize == Capacity * 2, "Load factor must be 0.5");
+    static constexpr std::size_t Mask = TableSize - 1;
+    using MetaAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<MetaEntry>;
+    using DataAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<DataEntry>;
+private:
+
+    struct LookupResult {
+        value_ptr  ptr;
+        index_type idx;
+        uint32_t   gen;
+    };
+
+    using hasher = typename key_traits<KeyType>::hasher;
+    using key_equal = typename key_traits<KeyType>::key_equal;
+
+    template <typename K>
+    std::size_t calculate_hash_idx(const K& key) const noexcept {
+        return hasher{}(key) & Mask;
+    }
+
+    std::size_t next_slot(std::size_t current_idx) const noexcept {
+        return (current_idx + 1) & Mask;
+    }
+
+    void detach(const index_type& idx) noexcept {
+        auto& meta = _meta_table[idx];
+        const index_type n = meta.next;
+        const index_type p = meta.prev;
+
+        if (n != NullIdx) [[likely]] { _meta_table[n].prev = p; }
+        else _tails[meta.list] = p;
 
         if (p != NullIdx) [[likely]] { _meta_table[p].next = n; }
-        else _head = n;
+        else _heads[meta.list] = n;
 
         meta.next = NullIdx;
         meta.prev = NullIdx;
+        _lengths[meta.list]--;
     }
 
-    void push_front(index_type idx) noexcept {
+    // Tombstones followed by an Empty slot end no probe chain: they can be Empty again
+    // Without it a table under churn ends up full of Deleted slots and every miss scans it all
+    void collapse_tombstones(std::size_t idx) noexcept {
+        if (_meta_table[next_slot(idx)].state.load(std::memory_order_relaxed) != slot_state::Empty) return;
+
+        for (std::size_t i = 0; i < TableSize; ++i) {
+            auto& meta = _meta_table[idx];
+            if (meta.state.load(std::memory_order_relaxed) != slot_state::Deleted) break;
+
+            meta.state.store(slot_state::Empty, std::memory_order_release);
+            idx = (idx - 1) & Mask;
+        }
+    }
+
+    // Occupied slot of a previous era reads as Deleted
+    bool is_live(const MetaEntry& meta) const noexcept {
+        return meta.state.load(std::memory_order_relaxed) == slot_state::Occupied &&
+               meta.era.load(std::memory_order_relaxed) == _era.load(std::memory_order_relaxed);
+    }
+
+    // Seqlock write, the value goes to retire(key, value): lockless readers may still copy it
+    template <typename R>
+    void destroy_slot(std::size_t idx, R&& retire) {
+        auto& meta = _meta_table[idx];
+        meta.gen.fetch_add(1, std::memory_order_release);
+
+        retire(std::as_const(meta.key), std::move(_data_table[idx].value));
+        _data_table[idx].value = nullptr;
+        meta.key.release(_key_arena);
+
+        meta.state.store(slot_state::Deleted, std::memory_order_relaxed);
+        meta.gen.fetch_add(1, std::memory_order_release);
+        meta.gen.notify_all();
+        collapse_tombstones(idx);
+    }
+
+    void push_front(index_type idx, uint8_t list = T2) noexcept {
         auto& meta = _meta_table[idx];
-        const index_type old_head = _head;
+        auto& head = _heads[list];
+        const index_type old_head = head;
 
-        meta.next = _head;
+        meta.list = list;
+        meta.next = old_head;
         meta.prev = NullIdx;
 
         if (old_head != NullIdx) [[likely]] { _meta_table[old_head].prev = idx; }
-        _head = idx;
+        head = idx;
+
+        if (_tails[list] == NullIdx) [[unlikely]] { _tails[list] = idx; }
+        _lengths[list]++;
+    }
+
+    void reprioritize(MetaEntry& meta) noexcept {
+        meta.policy.priority = _clock + static_cast<float>(meta.policy.hits) * meta.policy.cost;
+    }
+
+    // Priorities are relative to the clock: shifting all of them keeps the order
+    void rebase_clock() noexcept {
+        for (index_type idx = _heads[T2]; idx != NullIdx; idx = _meta_table[idx].next) {
+            _meta_table[idx].policy.priority = std::max(_meta_table[idx].policy.priority - _clock, 0.0f);
+        }
+        _clock = 0;
+    }
 
-        if (_tail == NullIdx) [[unlikely]] { _tail = idx; }
+    static constexpr std::array<index_type, Lists> make_links() noexcept {
+        std::array<index_type, Lists> links;
+        links.fill(NullIdx);
+        return links;
+    }
+
+    // SLRU: the protected LRU gets another chance in probation
+    void demote() noexcept {
+        const index_type idx = _tails[T2];
+        detach(idx);
+        push_front(idx, T1);
+    }
+
+    std::size_t hash_of(index_type idx) const {
+        return hasher{}(_meta_table[idx].key.load());
+    }
+
+    // ARC invariants: |T1| + |B1| <= c, |T1| + |T2| + |B1| + |B2| <= 2c
+    std::array<std::size_t, 2> ghost_bounds() const noexcept {
+        const std::size_t b1 = Capacity - std::min(_lengths[T1], Capacity);
+        const std::size_t b1_size = _ghosts.size(0, b1);
+        const std::size_t b2 = 2 * Capacity - std::min(_lengths[T1] + _lengths[T2] + b1_size, 2 * Capacity);
+        return {b1, b2};
     }
 
 public:
@@ -1845,22 +3155,25 @@ public:
     }
 
     bool is_valid_gen(index_type idx, uint32_t gen) const noexcept {
-        return _meta_table[idx].state == slot_state::Occupied && _meta_table[idx].gen == gen;
+        return is_live(_meta_table[idx]) && _meta_table[idx].gen == gen;
     }
 
     std::size_t size() const noexcept { return _size; }
-    index_type get_tail() const noexcept { return _tail; }
-    index_type get_head() const noexcept { return _head; }
+    index_type get_tail() const noexcept { return _lengths[T1] ? _tails[T1] : _tails[T2]; }      // Coldest
+    index_type get_head() const noexcept { return _heads[T2]; }                                 // Where hits go
 
     // Uses by writer (under lock)
     // Fast lookup: returns index and gen without copying shared_ptr
-    LookupResult lookup(const KeyType& key) const noexcept {
-        std::size_t idx = calculate_hash_idx(key);
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    LookupResult lookup(const K& key) const noexcept {
+        const std::size_t hash = hasher{}(key);
+        std::size_t idx = hash & Mask;
         index_type first_del = NullIdx;
 
         _meta_table.prefetch(idx);
 
-        while (true) {
+        for (std::size_t i = 0; i < TableSize; ++i) {
             const auto& meta = _meta_table[idx];
             const auto state = meta.state.load(std::memory_order_relaxed);
 
@@ -1869,14 +3182,12 @@ public:
                 return {nullptr, target, 0};
             }
 
-            if (state == slot_state::Deleted) {
-                if (first_del == NullIdx) first_del = static_cast<index_type>(idx);
-            }
-
-            if (state == slot_state::Occupied) {
-                if (meta.key == key) {
+            if (is_live(meta)) {
+                if (meta.key.matches(key, hash)) {
                     return { _data_table[idx].value, static_cast<index_type>(idx), meta.gen.load(std::memory_order_relaxed) };
                 }
+            } else if (first_del == NullIdx) { // Deleted or stale
+                first_del = static_cast<index_type>(idx);
             }
 
             idx = next_slot(idx);
@@ -1885,15 +3196,19 @@ public:
             }
         }
 
-        // It can loop for eternity only if Load Factor > 1.0 (all slots are Occupied or Deleted)
-        // But since it has Capacity * 2 and there is no deletion of Empty slots, this is impossible.
-        assert(false && "LinkedFlatMap table size overflow or corrupted logic");
-        __builtin_unreachable(); // I'm sure
+        // No Empty slot on the whole way: all slots are Occupied or Deleted
+        // Size is bounded by Capacity (TableSize / 2), so there is a Deleted one to reuse
+        assert(first_del != NullIdx && "LinkedFlatMap table size overflow or corrupted logic");
+        return {nullptr, first_del, 0};
     }
 
     // Uses by reader (lockless)
-    LookupResult get_lockless(const KeyType& key) const noexcept {
-        std::size_t idx = calculate_hash_idx(key);
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    LookupResult get_lockless(const K& key) const noexcept {
+        const std::size_t hash = hasher{}(key);
+        const uint32_t era = _era.load(std::memory_order_acquire);
+        std::size_t idx = hash & Mask;
 
         for (std::size_t i = 0; i < TableSize; ++i) {
             const auto& meta = _meta_table[idx];
@@ -1909,9 +3224,8 @@ public:
             const auto state = meta.state.load(std::memory_order_relaxed);
             if (state == slot_state::Empty) return {nullptr, NullIdx, 0};
 
-            if (state == slot_state::Occupied) {
-                std::atomic_ref<const KeyType> key_ref(meta.key);
-                if (key_ref.load(std::memory_order_relaxed) == key) {
+            if (state == slot_state::Occupied && meta.era.load(std::memory_order_relaxed) == era) {
+                if (meta.key.matches(key, hash)) {
                     auto val_ref = _data_table[idx].value; //SAFETY Thrust me, I know what i'm doing
 
                     if (meta.gen.load(std::memory_order_acquire) == gen1) [[likely]] {
@@ -1925,48 +3239,150 @@ public:
         return {nullptr, NullIdx, 0};
     }
 
-    void emplace_at(index_type idx, const key_type& key, value_ptr&& new_ptr) noexcept {
+    // Uses by writer (under lock), before an insert mutates anything: emplace_at() can't fail afterwards
+    [[nodiscard]] bool reserve_key(const key_type& key) noexcept {
+        return key_slot::reserve(key, _key_arena);
+    }
+
+    // Links the slot at the head
+    // Returns the value of a reused stale slot: lockless readers may still copy it
+    value_ptr emplace_at(index_type idx, const key_type& key, value_ptr&& new_ptr, const Admission& admission = {}) noexcept {
         auto& meta = _meta_table[idx];
         auto& data = _data_table[idx];
 
         meta.gen.fetch_add(1, std::memory_order_release);    // This is important to avoid dirty read
-        std::atomic_ref<KeyType> key_ref(meta.key);
-        key_ref.store(key, std::memory_order_relaxed);       // Data race avoidance
+        if (meta.state.load(std::memory_order_relaxed) == slot_state::Occupied) _stale--;
+
+        meta.key.store(key, hasher{}(key), _key_arena);
+        meta.era.store(_era.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        meta.next = NullIdx;
+        meta.prev = NullIdx;
 
-        data.value = std::move(new_ptr); // Memory had been allocated by assign_slot
+        value_ptr old_ptr = std::exchange(data.value, std::move(new_ptr)); // Memory had been allocated by assign_slot
 
         meta.state.store(slot_state::Occupied, std::memory_order_release);
         meta.gen.fetch_add(1, std::memory_order_release);
         meta.gen.notify_all();
         _size++;
+
+        if constexpr (Policy == EvictionPolicy::GDSF) {
+            meta.policy.cost = admission.cost;
+            meta.policy.hits = 1;
+            reprioritize(meta);
+        }
+        push_front(idx, admission.ghost == GhostHit::None ? T1 : T2); // ARC: a ghost hit is the second sight
+
+        return old_ptr;
+    }
+
+    // Uses by writer (under lock), before victim() and emplace_at()
+    // ARC: a ghost hit moves the T1 target towards the list that would have kept the key
+    template <typename K>
+    Admission admit(const K& key, float cost = 1.0f) noexcept {
+        Admission admission{std::max(cost, 0.0f)};
+
+        if constexpr (Policy == EvictionPolicy::ARC) {
+            const auto bounds = ghost_bounds();
+            const std::size_t b1 = std::max<std::size_t>(_ghosts.size(0, bounds[0]), 1);
+            const std::size_t b2 = std::max<std::size_t>(_ghosts.size(1, bounds[1]), 1);
+
+            admission.ghost = _ghosts.take(hasher{}(key), bounds);
+            if (admission.ghost == GhostHit::B1) {
+                _target = std::min(_target + std::max<std::size_t>(b2 / b1, 1), Capacity);
+            } else if (admission.ghost == GhostHit::B2) {
+                _target -= std::min(_target, std::max<std::size_t>(b1 / b2, 1));
+            }
+        }
+        return admission;
+    }
+
+    // Slot to free for the admitted key, the map must be non-empty
+    index_type victim([[maybe_unused]] const Admission& admission) noexcept {
+        if constexpr (Policy == EvictionPolicy::GDSF) {
+            std::array<index_type, GdsfSample> sample;
+            std::size_t sampled = 0;
+            index_type best = _tails[T2];
+
+            for (index_type idx = _tails[T2]; sampled < GdsfSample && idx != NullIdx; idx = _meta_table[idx].prev) {
+                if (_meta_table[idx].policy.priority < _meta_table[best].policy.priority) best = idx;
+                sample[sampled++] = idx;
+            }
+
+            _clock = std::max(_clock, _meta_table[best].policy.priority); // Inflation: survivors age
+
+            // Worth more than the clock: another round from the head, so the next sample sees new candidates
+            // It's their priority, not a hit, that keeps them: the clock catches up with them eventually
+            for (std::size_t i = 0; i < sampled; ++i) {
+                if (sample[i] != best && _meta_table[sample[i]].policy.priority > _clock) {
+                    detach(sample[i]);
+                    push_front(sample[i]);
+                }
+            }
+
+            if (_clock >= GdsfRebaseAt) [[unlikely]] rebase_clock();
+            return best;
+        } else if constexpr (Policy == EvictionPolicy::ARC) {
+            // REPLACE: T1 gives up its LRU while it's over the target, the victim's key becomes a ghost
+            const std::size_t t1 = _lengths[T1];
+            const bool from_t1 = t1 > 0 && (t1 > _target || (admission.ghost == GhostHit::B2 && t1 == _target) || _lengths[T2] == 0);
+            const uint8_t list = from_t1 ? T1 : T2;
+            const index_type idx = _tails[list];
+
+            _ghosts.insert(hash_of(idx), list, ghost_bounds());
+            return idx;
+        } else {
+            return get_tail(); // SLRU: probation first
+        }
+    }
+
+    // SLRU: protected segment size as a share of Capacity, (0, 1]
+    void set_protected_share(double share) noexcept requires (Policy == EvictionPolicy::SLRU) {
+        _protected_cap = std::clamp<std::size_t>(static_cast<std::size_t>(share * Capacity), 1, Capacity);
+        while (_lengths[T2] > _protected_cap) demote();
+    }
+
+    // New cost of a live slot, GDSF only
+    void reprice(index_type idx, float cost) noexcept {
+        if constexpr (Policy == EvictionPolicy::GDSF) {
+            _meta_table[idx].policy.cost = std::max(cost, 0.0f);
+            reprioritize(_meta_table[idx]);
+        }
     }
 
     index_type assign_slot(const key_type& key) noexcept {
         std::size_t idx = calculate_hash_idx(key);
         index_type first_deleted = NullIdx;
 
-        while (true) {
+        for (std::size_t i = 0; i < TableSize; ++i) {
             const auto state = _meta_table[idx].state.load(std::memory_order_relaxed);
 
             if (state == slot_state::Empty) {
                 return (first_deleted != NullIdx) ? first_deleted : static_cast<index_type>(idx);
             }
 
-            if (state == slot_state::Deleted) {
-                if (first_deleted == NullIdx) {
-                    first_deleted = static_cast<index_type>(idx);
-                }
+            if (first_deleted == NullIdx && !is_live(_meta_table[idx])) { // Deleted or stale
+                first_deleted = static_cast<index_type>(idx);
             }
 
             idx = next_slot(idx);
         }
 
-        assert(false && "LinkedFlatMap table size overflow or corrupted logic");
-        __builtin_unreachable(); // I'm sure
+        assert(first_deleted != NullIdx && "LinkedFlatMap table size overflow or corrupted logic");
+        return first_deleted;
     }
 
+    // A hit
     void move_to_front(index_type idx) noexcept {
-        if (idx == _head || idx == NullIdx) return;
+        if (idx == NullIdx) return;
+
+        if constexpr (Policy == EvictionPolicy::GDSF) {
+            auto& meta = _meta_table[idx];
+            if (meta.policy.hits < std::numeric_limits<uint32_t>::max()) meta.policy.hits++;
+            reprioritize(meta);
+        }
+
+        // ARC: T1 -> T2 on the second sight, T2 stays in T2
+        if (idx == _heads[T2] && _meta_table[idx].list == T2) return;
 
         const index_type n = _meta_table[idx].next;
         const index_type p = _meta_table[idx].prev;
@@ -1974,36 +3390,314 @@ public:
         if (n != NullIdx) sizes::prefetch(&_meta_table[n], 1);
         if (p != NullIdx) sizes::prefetch(&_meta_table[p], 1);
 
-        detach(idx);
-        push_front(idx);
+        detach(idx); // Every live slot is linked by emplace_at()
+        push_front(idx, T2);
+
+        if constexpr (Policy == EvictionPolicy::SLRU) {
+            if (_lengths[T2] > _protected_cap) demote();
+        }
     }
 
     void erase_index(const index_type& idx) noexcept {
-        if (idx == NullIdx || _meta_table[idx].state != slot_state::Occupied) return;
+        if (idx == NullIdx || !is_live(_meta_table[idx])) return;
 
         detach(idx);
 
-        _meta_table[idx].gen.fetch_add(1, std::memory_order_release);
-
         // The object is alive as long as the reader holds it
-        _data_table[idx].value = nullptr;
-
-        _meta_table[idx].state.store(slot_state::Deleted, std::memory_order_relaxed);
-        _meta_table[idx].gen.fetch_add(1, std::memory_order_release);
-        _meta_table[idx].gen.notify_all();
-
+        destroy_slot(idx, [](const key_slot&, value_ptr&&) {});
         _size--;
     }
 
-private:
-    FlatStorage<MetaEntry, MetaAlloc> _meta_table{TableSize};
-    FlatStorage<DataEntry, DataAlloc> _data_table{TableSize};
-    index_type _head = NullIdx;
-    index_type _tail = NullIdx;
-    std::size_t _size = 0;
-};
+    // O(1): slots of the previous era read as Deleted, they're reclaimed on reuse or by sweep()
+    void clear() noexcept {
+        _stale += _size;
+        _size = 0;
+        _heads.fill(NullIdx);
+        _tails.fill(NullIdx);
+        _lengths.fill(0);
+        _clock = 0;
+        _target = 0;
+        if constexpr (Policy == EvictionPolicy::ARC) _ghosts.clear();
+        _era.fetch_add(1, std::memory_order_release);
+    }
 
-template <typename Derived, std::size_t MaxThreads>
+    // Frees a stale slot before its reuse, so its value can be retired with the key
+    template <typename R>
+    void reclaim_stale(index_type idx, R&& retire) {
+        const auto& meta = _meta_table[idx];
+        if (meta.state.load(std::memory_order_relaxed) != slot_state::Occupied || is_live(meta)) return;
+
+        destroy_slot(idx, retire);
+        _stale--;
+    }
+
+    // Reclaims stale slots among the next `budget` ones, amortized over writers
+    template <typename R>
+    std::size_t sweep(std::size_t budget, R&& retire) {
+        std::size_t reclaimed = 0;
+        const uint32_t era = _era.load(std::memory_order_relaxed);
+
+        for (; budget > 0 && _stale > 0; --budget) {
+            const std::size_t idx = _sweep_cursor;
+            _sweep_cursor = next_slot(_sweep_cursor);
+
+            const auto& meta = _meta_table[idx];
+            if (meta.state.load(std::memory_order_relaxed) == slot_state::Occupied &&
+                meta.era.load(std::memory_order_relaxed) != era) {
+                destroy_slot(idx, retire);
+                _stale--;
+                reclaimed++;
+            }
+        }
+        return reclaimed;
+    }
+
+    // Uses by writer (under lock)
+    // Erases live slots of [first, last) matching pred(key, value), values go to retire(key, value)
+    template <typename P, typename R>
+    std::size_t erase_if(std::size_t first, std::size_t last, P&& pred, R&& retire) {
+        std::size_t erased = 0;
+        last = std::min(last, TableSize);
+
+        for (std::size_t idx = first; idx < last; ++idx) {
+            const auto& meta = _meta_table[idx];
+            if (!is_live(meta) || !pred(meta.key.load(), *_data_table[idx].value)) continue;
+
+            detach(static_cast<index_type>(idx));
+            destroy_slot(idx, retire);
+            _size--;
+            erased++;
+        }
+        return erased;
+    }
+
+    static constexpr std::size_t slot_count() noexcept { return TableSize; }
+
+    // Uses by reader (lockless), writers are never blocked
+    // Visits Occupied slots of [first, last), every one is validated by its gen like get_lockless()
+    // Slot changed during the visit is skipped
+    template <typename F>
+    std::size_t scan(std::size_t first, std::size_t last, F&& visitor) const {
+        std::size_t visited = 0;
+        last = std::min(last, TableSize);
+
+        for (std::size_t idx = first; idx < last; ++idx) {
+            const auto& meta = _meta_table[idx];
+
+            const uint32_t gen1 = meta.gen.load(std::memory_order_acquire);
+            if (gen1 & 1) [[unlikely]] continue; // Writer is here: don't wait for it
+
+            if (!is_live(meta)) continue;
+
+            const KeyType key = meta.key.load();
+            auto val_ref = _data_table[idx].value; //SAFETY Same as get_lockless(), caller holds an epoch
+
+            if (meta.gen.load(std::memory_order_acquire) != gen1 || !val_ref) [[unlikely]] continue;
+
+            visitor(key, val_ref);
+            visited++;
+        }
+
+        return visited;
+    }
+
+    // Uses by writer (under lock)
+    // LRU order from cold to hot: replaying it with move_to_front() restores the list
+    // ARC & SLRU: T1 then T2, a replay lands in T1
+    template <typename F>
+    void for_each_from_tail(F&& func) const {
+        for (std::size_t list = 0; list < Lists; ++list) {
+            for (index_type idx = _tails[list]; idx != NullIdx; idx = _meta_table[idx].prev) {
+                func(_meta_table[idx].key.load(), _data_table[idx].value);
+            }
+        }
+    }
+
+    // ARC: T1 target size, grows with B1 hits
+    std::size_t target() const noexcept { return _target; }
+
+private:
+    FlatStorage<MetaEntry, MetaAlloc> _meta_table{TableSize};
+    FlatStorage<DataEntry, DataAlloc> _data_table{TableSize};
+    [[no_unique_address]] typename key_slot::arena_type _key_arena;
+    std::array<index_type, Lists> _heads = make_links();
+    std::array<index_type, Lists> _tails = make_links();
+    std::array<std::size_t, Lists> _lengths{};
+    std::size_t _size = 0;
+    std::size_t _stale = 0;
+    std::size_t _sweep_cursor = 0;
+    std::atomic<uint32_t> _era{0};
+    float _clock = 0;                   // GDSF inflation
+    std::size_t _target = 0;            // ARC
+    std::size_t _protected_cap = static_cast<std::size_t>(DefaultProtectedShare * Capacity); // SLRU
+    [[no_unique_address]] ghost_table _ghosts;
+};
+
+/*  Warm restart
+*   File:       Header | ShardIndex[shards] | shard sections (page aligned)
+*   Section:    Record[count], LRU order from cold to hot
+*   Writer streams through a big buffer, reader maps the file and restores shards in parallel
+*/
+namespace snapshot {
+    inline constexpr uint64_t Magic = 0x31504E534C52554CULL;   // "LURLSNP1"
+    inline constexpr uint32_t Version = 1;
+    inline constexpr std::size_t PageSize = 4 * sizes::KiB;
+
+    template <typename T>
+    concept Trivial = std::is_trivially_copyable_v<T>;
+
+    template <typename KeyType, typename ValueType>
+    struct Record {
+        KeyType     key;
+        ValueType   value;
+    };
+
+    struct Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t shards;
+        uint64_t shard_capacity;
+        uint32_t key_size;
+        uint32_t value_size;
+        uint32_t record_size;
+        uint32_t record_align;
+    };
+
+    struct ShardIndex {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    // Large sequential writes into <path>.tmp, renamed on success: a crash never leaves a torn snapshot
+    class Writer : private NonCopyableNonMoveable {
+        static constexpr std::size_t BufferSize = 4 * sizes::MiB;
+
+        bool flush_buffer() noexcept {
+            std::size_t done = 0;
+            while (_ok && done < _used) {
+                ssize_t n = ::write(_fd, _buffer.get() + done, _used - done);
+                if (n <= 0) _ok = false;
+                else done += static_cast<std::size_t>(n);
+            }
+            _used = 0;
+            return _ok;
+        }
+
+    public:
+        explicit Writer(const std::string& path) : _path(path), _tmp_path(path + ".tmp"),
+                                                   _buffer(std::make_unique<std::byte[]>(BufferSize)) {
+            _fd = ::open(_tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            _ok = _fd >= 0;
+        }
+
+        ~Writer() {
+            if (_fd >= 0) {
+                ::close(_fd);
+                ::unlink(_tmp_path.c_str()); // finish() wasn't called or failed
+            }
+        }
+
+        bool write(const void* src, std::size_t n) noexcept {
+            const auto* bytes = static_cast<const std::byte*>(src);
+            _written += n;
+
+            while (_ok && n > 0) {
+                const std::size_t chunk = std::min(n, BufferSize - _used);
+                std::memcpy(_buffer.get() + _used, bytes, chunk);
+                _used += chunk;
+                bytes += chunk;
+                n -= chunk;
+
+                if (_used == BufferSize) flush_buffer();
+            }
+            return _ok;
+        }
+
+        bool pad_to(std::size_t alignment) noexcept {
+            static constexpr std::byte zeros[PageSize]{};
+            std::size_t pad = (alignment - (_written & (alignment - 1))) & (alignment - 1);
+            return write(zeros, pad);
+        }
+
+        uint64_t position() const noexcept { return _written; }
+
+        bool finish() noexcept {
+            flush_buffer();
+            if (_ok) _ok = ::fsync(_fd) == 0;
+            _ok = (::close(_fd) == 0) && _ok;
+            _fd = -1;
+
+            if (_ok) _ok = std::rename(_tmp_path.c_str(), _path.c_str()) == 0;
+            else ::unlink(_tmp_path.c_str());
+            return _ok;
+        }
+
+    private:
+        std::string                     _path;
+        std::string                     _tmp_path;
+        std::unique_ptr<std::byte[]>    _buffer;
+        std::size_t                     _used = 0;
+        uint64_t                        _written = 0;
+        int                             _fd = -1;
+        bool                            _ok = false;
+    };
+
+    // Read-only mapping of the whole file
+    class MappedFile : private NonCopyableNonMoveable {
+    public:
+        explicit MappedFile(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return;
+
+            struct stat st{};
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+                if (ptr != MAP_FAILED) {
+                    madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+                    _data = static_cast<const std::byte*>(ptr);
+                    _size = static_cast<std::size_t>(st.st_size);
+                }
+            }
+            ::close(fd);
+        }
+
+        ~MappedFile() { if (_data) munmap(const_cast<std::byte*>(_data), _size); }
+
+        bool valid() const noexcept { return _data != nullptr; }
+        const std::byte* data() const noexcept { return _data; }
+        std::size_t size() const noexcept { return _size; }
+
+    private:
+        const std::byte*    _data = nullptr;
+        std::size_t         _size = 0;
+    };
+}
+
+/*  Removal listener
+*   Events are queued per cache under its lock and handed over in batches after unlock:
+*   by the writer itself or through a caller-supplied executor
+*   Cleared entries are reported by clear() itself, while it sweeps the old slots
+*   Queuing never throws: an event that can't be allocated is dropped and counted by lost_removals()
+*/
+enum class RemovalReason : uint8_t { Evicted, Replaced, Erased, Cleared };
+
+template <typename KeyType, typename ValueType>
+struct RemovalEvent {
+    KeyType                     key;
+    std::shared_ptr<ValueType>  value;
+    RemovalReason               reason;
+};
+
+template <typename KeyType, typename ValueType>
+struct RemovalListener {
+    using event_type = RemovalEvent<KeyType, ValueType>;
+
+    std::function<void(std::span<const event_type>)>    on_removal;
+    std::function<void(std::function<void()>)>          executor;   // Empty: the writer delivers after unlock
+    std::size_t                                         batch = 64;
+};
+
+template <typename Derived, std::size_t MaxThreads>
 class EpochManager {
     static constexpr std::size_t CacheLine = sizes::CacheLine;
 
@@ -2015,20 +3709,27 @@ public:
     struct [[nodiscard]] Guard {
         EpochManager*   owner;
         std::size_t     tid;
-        ~Guard() { owner->leave_epoch(tid); }
+        uint64_t        outer;  // Epoch of the enclosing guard (0 if none)
+        ~Guard() { owner->leave_epoch(tid, outer); }
     };
 
     uint64_t current_epoch() const noexcept {
         return _global_epoch.load(std::memory_order_relaxed);
     }
 
+    // Reentrant: get() from a scan visitor must not drop the scan's protection
     Guard enter_epoch(std::size_t tid) noexcept {
-        _thread_states[tid].active_epoch.store(_global_epoch.load(std::memory_order_relaxed), std::memory_order_release);
-        return {this, tid};
+        auto& active = _thread_states[tid].active_epoch;
+        const uint64_t outer = active.load(std::memory_order_relaxed);
+
+        if (outer == 0) [[likely]] {
+            active.store(_global_epoch.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+        return {this, tid, outer};
     }
 
-    void leave_epoch(std::size_t tid) noexcept {
-        _thread_states[tid].active_epoch.store(0, std::memory_order_release);
+    void leave_epoch(std::size_t tid, uint64_t outer = 0) noexcept {
+        _thread_states[tid].active_epoch.store(outer, std::memory_order_release);
     }
 
     uint64_t bump_epoch() noexcept {
@@ -2050,28 +3751,182 @@ private:
     std::atomic<uint64_t>               _global_epoch{1};
 };
 
-template <Hashable KeyType, typename ValueType, std::size_t Capacity = 4 * 1024, std::size_t MaxThreads = 32>
+// Strict: promotion under the writer lock right in get(), Deferred: through the SPSC buffers
+enum class RecencyMode : uint8_t { Strict, Deferred };
+
+// Hit: the value, Miss: not cached, ask the backend, Absent: the backend recently confirmed there's nothing
+enum class Presence : uint8_t { Hit, Miss, Absent };
+
+/*  Negative cache: keys the backend confirmed missing, no slot in the table and no value allocation
+*   4 fingerprints + deadlines per cache line, lookup is one probe and readers take no lock
+*   The fingerprint is a bijective mix of the hash: two keys share a marker only if their hashes are equal
+*   Writers hold the cache lock; a full bucket drops the entry closest to expiry, expire() sweeps the rest
+*/
+template <std::size_t Capacity>
+class AbsentFilter : private NonCopyableNonMoveable {
+    static constexpr std::size_t Ways = 4;
+    static constexpr std::size_t Buckets = std::max<std::size_t>(16, std::bit_ceil(Capacity / 4) / Ways);
+
+    struct alignas(sizes::CacheLine) Bucket {
+        std::atomic<uint64_t>   tag[Ways]{};        // 0 is empty
+        std::atomic<int64_t>    deadline[Ways]{};   // steady_clock ticks
+    };
+
+    static uint64_t fingerprint(std::size_t hash) noexcept {
+        uint64_t h = hash ^ 0x9E3779B97F4A7C15ULL;  // Only this hash maps to the empty tag
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    Bucket& bucket_of(uint64_t tag) noexcept { return _buckets[tag & (Buckets - 1)]; }
+    const Bucket& bucket_of(uint64_t tag) const noexcept { return _buckets[tag & (Buckets - 1)]; }
+
+    static int64_t now() noexcept { return clock::now().time_since_epoch().count(); }
+
+public:
+    using clock = std::chrono::steady_clock;
+
+    AbsentFilter() : _buckets(std::make_unique<Bucket[]>(Buckets)) {}
+
+    // Lockless: a writer replacing the entry clears the tag first, so the deadline is re-validated by the tag
+    bool contains(std::size_t hash) const noexcept {
+        const uint64_t tag = fingerprint(hash);
+        const auto& bucket = bucket_of(tag);
+        for (std::size_t w = 0; w < Ways; ++w) {
+            if (bucket.tag[w].load(std::memory_order_acquire) != tag) continue;
+
+            const int64_t deadline = bucket.deadline[w].load(std::memory_order_acquire);
+            if (bucket.tag[w].load(std::memory_order_relaxed) != tag) [[unlikely]] return false;
+            return now() < deadline;
+        }
+        return false;
+    }
+
+    void insert(std::size_t hash, clock::duration ttl) noexcept {
+        const uint64_t tag = fingerprint(hash);
+        if (tag == 0) [[unlikely]] return;
+
+        auto& bucket = bucket_of(tag);
+        const int64_t t = now();
+        std::size_t way = 0;
+        int64_t earliest = std::numeric_limits<int64_t>::max();
+        for (std::size_t w = 0; w < Ways; ++w) {
+            const uint64_t current = bucket.tag[w].load(std::memory_order_relaxed);
+            if (current == tag) {   // Refresh
+                bucket.deadline[w].store(t + ttl.count(), std::memory_order_release);
+                return;
+            }
+            const int64_t deadline = current ? bucket.deadline[w].load(std::memory_order_relaxed)
+                                             : std::numeric_limits<int64_t>::min();
+            if (deadline < earliest) {
+                earliest = deadline;
+                way = w;
+            }
+        }
+
+        if (bucket.tag[way].load(std::memory_order_relaxed) == 0) {
+            _count.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            bucket.tag[way].store(0, std::memory_order_relaxed);
+        }
+        bucket.deadline[way].store(t + ttl.count(), std::memory_order_release);
+        bucket.tag[way].store(tag, std::memory_order_release);
+    }
+
+    // The key was put: its marker must not outlive the write
+    void erase(std::size_t hash) noexcept {
+        const uint64_t tag = fingerprint(hash);
+        auto& bucket = bucket_of(tag);
+        for (std::size_t w = 0; w < Ways; ++w) {
+            if (bucket.tag[w].load(std::memory_order_relaxed) == tag) {
+                bucket.tag[w].store(0, std::memory_order_release);
+                _count.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    // Amortized over writers: markers past their deadline leave, so empty() turns true again
+    void expire(std::size_t buckets) noexcept {
+        const int64_t t = now();
+        for (; buckets > 0 && !empty(); --buckets) {
+            auto& bucket = _buckets[_cursor];
+            _cursor = (_cursor + 1) & (Buckets - 1);
+
+            for (std::size_t w = 0; w < Ways; ++w) {
+                if (bucket.tag[w].load(std::memory_order_relaxed) != 0 &&
+                    bucket.deadline[w].load(std::memory_order_relaxed) <= t) {
+                    bucket.tag[w].store(0, std::memory_order_release);
+                    _count.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    void clear() noexcept {
+        if (_count.load(std::memory_order_relaxed) == 0) return;
+
+        for (std::size_t i = 0; i < Buckets; ++i) {
+            for (auto& tag : _buckets[i].tag) tag.store(0, std::memory_order_release);
+        }
+        _count.store(0, std::memory_order_relaxed);
+    }
+
+    // Markers in the filter, expired ones included until they are replaced or swept
+    std::size_t size() const noexcept { return _count.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return size() == 0; }
+
+private:
+    std::unique_ptr<Bucket[]>   _buckets;
+    std::atomic<std::size_t>    _count{0};
+    std::size_t                 _cursor = 0;    // expire(), writers only
+};
+
+template <Hashable KeyType, typename ValueType, std::size_t Capacity = 4 * 1024, std::size_t MaxThreads = 32,
+          typename Lock = HybridLock<>, EvictionPolicy Policy = EvictionPolicy::LRU>
 requires PowerOfTwoValue<MaxThreads>
-class Lv5_bdFlatLRU :   public EpochManager<Lv5_bdFlatLRU<KeyType, ValueType, Capacity, MaxThreads>, MaxThreads>,
+class Lv5_bdFlatLRU :   public EpochManager<Lv5_bdFlatLRU<KeyType, ValueType, Capacity, MaxThreads, Lock, Policy>, MaxThreads>,
                         private NonCopyableNonMoveable {
 public:
-    static constexpr const char* name() noexcept { return "Lv5_SPSCBuffer_DeferredFlatLRU"; }
+    static constexpr const char* name() noexcept {
+        if constexpr (Policy == EvictionPolicy::GDSF) return "Lv5_SPSCBuffer_DeferredFlatGDSF";
+        else if constexpr (Policy == EvictionPolicy::ARC) return "Lv5_SPSCBuffer_DeferredFlatARC";
+        else if constexpr (Policy == EvictionPolicy::SLRU) return "Lv5_SPSCBuffer_DeferredFlatSLRU";
+        else return "Lv5_SPSCBuffer_DeferredFlatLRU";
+    }
     using value_type = ValueType;
     using key_type = KeyType;
 
 private:
-    using cacheMap = Lv3_LinkedFlatMap<KeyType, ValueType, Capacity>;
+    using cacheMap = Lv3_LinkedFlatMap<KeyType, ValueType, Capacity, Policy>;
+    using Absent = AbsentFilter<Capacity>;
     static constexpr std::size_t CacheLine = sizes::CacheLine;
 
-    struct alignas(CacheLine) UpdateOp {
+    struct UpdateOp {      // 16 B slot together with the ring's stamp
         cacheMap::index_type    idx;
         uint32_t                gen;
     };
 
-    using SPSCBuffer = SPSC_RingBufferUltraFast<UpdateOp, Capacity / (4 * MaxThreads)>;
-    using BaseEpochManager = EpochManager<Lv5_bdFlatLRU<KeyType, ValueType, Capacity, MaxThreads>, MaxThreads>;
+    static constexpr std::size_t BufferCapacity = Capacity / (4 * MaxThreads);
+    using SPSCBuffer = SPSC_TraceRing<UpdateOp, BufferCapacity, TraceOverflow::OverwriteOldest>;
+    using BaseEpochManager = EpochManager<Lv5_bdFlatLRU<KeyType, ValueType, Capacity, MaxThreads, Lock, Policy>, MaxThreads>;
+
+    static constexpr std::size_t EraseChunk = 256;     // Slots per lock hold in erase_if()
+    static constexpr std::size_t SweepBudget = 8;      // Slots per put() to reclaim after clear()
+    static constexpr std::chrono::nanoseconds AbsentTtl = std::chrono::seconds(1);  // put_absent() default
+
+    // Adaptive recency: hysteresis between the two thresholds, going strict needs a few quiet windows
+    static constexpr uint32_t AdaptWindow = 1024;          // Writes per decision
+    static constexpr uint32_t DeferredSpins = 32;          // Avg lock spins per write to go deferred
+    static constexpr uint32_t StrictSpins = 2;             // Avg lock spins per write to go strict
+    static constexpr uint32_t StrictAfterWindows = 4;
 
     static_assert(std::has_single_bit(MaxThreads), "MaxThreads must be a power of 2!");
+    static_assert(MaxThreads <= 64, "One bit per thread slot in a 64-bit mask");
 
 private:
     struct alignas(CacheLine) PaddedSPSC : public SPSCBuffer {
@@ -2083,19 +3938,50 @@ private:
         uint64_t epoch;
     };
 
+    using Listener = RemovalListener<KeyType, ValueType>;
+
+    struct PendingRemovals {
+        std::vector<RemovalEvent<KeyType, ValueType>>   events;
+        std::shared_ptr<const Listener>                 listener;
+    };
+
 private:
 
-    static std::size_t get_thread_id() {
-        static std::atomic<std::size_t> counter{0};
+    static constexpr std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+    static constexpr uint64_t AllSlots = MaxThreads == 64 ? ~uint64_t{0} : (uint64_t{1} << MaxThreads) - 1;
 
-        // rollcall
-        thread_local std::size_t id = std::numeric_limits<std::size_t>::max();
+    static std::atomic<uint64_t>& leased_slots() noexcept {
+        static std::atomic<uint64_t> mask{0};
+        return mask;
+    }
 
-        if (id == std::numeric_limits<std::size_t>::max()) [[unlikely]] {
-            id = counter.fetch_add(1, std::memory_order_relaxed) & (MaxThreads - 1);
+    // Epoch slot + SPSC ring of a live thread, handed back when it exits: short-lived threads
+    // (parallel_for_each workers) don't use the slots up, two live threads never share one
+    struct ThreadSlot {
+        std::size_t id = NoSlot;
+        ~ThreadSlot() {
+            if (id != NoSlot) leased_slots().fetch_and(~(uint64_t{1} << id), std::memory_order_release);
         }
+    };
 
-        return id;
+    // NoSlot: MaxThreads threads hold one already, the caller takes the locked path and asks again later
+    static std::size_t get_thread_id() noexcept {
+        thread_local ThreadSlot slot;
+
+        if (slot.id == NoSlot) [[unlikely]] {
+            auto& mask = leased_slots();
+            uint64_t seen = mask.load(std::memory_order_relaxed);
+            while (const uint64_t free = ~seen & AllSlots) {
+                const std::size_t id = std::countr_zero(free);
+                if (mask.compare_exchange_weak(seen, seen | (uint64_t{1} << id),
+                                               std::memory_order_acquire, std::memory_order_relaxed)) {
+                    slot.id = id;
+                    break;
+                }
+            }
+        }
+
+        return slot.id;
     }
 
     template<typename F>
@@ -2106,24 +3992,23 @@ private:
         }
     }
 
-    void process_buffer(int buf_idx) {
-        UpdateOp op;
-        auto& buffer = _update_buffers[buf_idx];
-
-        while (buffer.pop(op)) {
+    std::size_t process_buffer(int buf_idx) {
+        return _update_buffers[buf_idx].consume_all([this](const UpdateOp& op) {
             sizes::prefetch(&_collection.get_meta(_collection.get_head()), 1);
 
             if (_collection.is_valid_gen(op.idx, op.gen)) {
                 _collection.move_to_front(op.idx);
             }
-        }
+        });
     }
 
     void apply_updates() {
         uint64_t mask = _dirty_mask.exchange(0, std::memory_order_acquire);
         
         for_each_bit(mask, [this](int buf_idx) {
-            process_buffer(buf_idx);
+            if (process_buffer(buf_idx) >= BufferCapacity / 2) {
+                _window_full_drains++; // Readers outpace writers
+            }
         });
 
         if (!_retired_list.empty()) [[likely]] {
@@ -2132,16 +4017,128 @@ private:
     }
 
     void mark_access(cacheMap::index_type idx, uint32_t gen) noexcept {
+        // Quiet shard: StrictLRU-like immediate promotion, a busy lock falls back to the buffer
+        if (_recency.load(std::memory_order_relaxed) == RecencyMode::Strict) {
+            if (_lock.try_lock()) {
+                if (_collection.is_valid_gen(idx, gen)) {
+                    _collection.move_to_front(idx);
+                }
+                _lock.unlock();
+                return;
+            }
+            _contended.fetch_add(1, std::memory_order_relaxed);
+        }
+
         const auto tid = get_thread_id();
 
-        if (tid == std::numeric_limits<std::size_t>::max()) [[unlikely]] return;
+        if (tid == NoSlot) [[unlikely]] return;
 
-        if (_update_buffers[tid].push({idx, gen})) [[likely]] {
-            const uint64_t mask = 1ULL << tid;
-            if (!(_dirty_mask.load(std::memory_order_relaxed) & mask)) {    // Test
-                _dirty_mask.fetch_or(mask, std::memory_order_release);      // Test & Set bit in mask
+        // A full ring loses its oldest records, not this one: the lag shows up as full drains
+        _update_buffers[tid].push({idx, gen});
+
+        const uint64_t mask = 1ULL << tid;
+        if (!(_dirty_mask.load(std::memory_order_relaxed) & mask)) {    // Test
+            _dirty_mask.fetch_or(mask, std::memory_order_release);      // Test & Set bit in mask
+        }
+    }
+
+    // Under lock, one decision per AdaptWindow writes
+    void adapt_recency(uint32_t spins) noexcept {
+        _window_spins += spins;
+        if (++_window_writes < AdaptWindow || _recency_pinned) [[likely]] return;
+
+        const uint64_t contended = _contended.exchange(0, std::memory_order_relaxed) + _window_full_drains;
+        const bool hot = _window_spins > uint64_t{AdaptWindow} * DeferredSpins || contended > AdaptWindow / 16;
+        const bool quiet = _window_spins < uint64_t{AdaptWindow} * StrictSpins && contended == 0;
+
+        if (_recency.load(std::memory_order_relaxed) == RecencyMode::Strict) {
+            if (hot) switch_recency(RecencyMode::Deferred);
+        } else {
+            _quiet_windows = quiet ? _quiet_windows + 1 : 0;
+            if (_quiet_windows >= StrictAfterWindows) switch_recency(RecencyMode::Strict);
+        }
+
+        _window_writes = 0;
+        _window_spins = 0;
+        _window_full_drains = 0;
+    }
+
+    void switch_recency(RecencyMode mode) noexcept {
+        _recency.store(mode, std::memory_order_relaxed);
+        _quiet_windows = 0;
+        _recency_switches.store(_recency_switches.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Under lock, after bump_epoch(): readers of the current epoch may still copy the pointer
+    // Never throws, it runs inside noexcept writer paths
+    void retire(std::shared_ptr<ValueType>&& ptr) noexcept {
+        if (!ptr) return;
+        if (_retired_list.size() == _retired_list.capacity() && !grow_retired()) [[unlikely]] {
+            leak(std::move(ptr));
+            return;
+        }
+        _retired_list.push_back({std::move(ptr), this->current_epoch()});
+    }
+
+    // Out of memory: room is made by freeing what no reader can see anymore
+    bool grow_retired() noexcept {
+        try {
+            _retired_list.reserve(std::max<std::size_t>(64, 2 * _retired_list.capacity()));
+            return true;
+        } catch (...) {
+            this->cleanup_retired();
+            return _retired_list.size() < _retired_list.capacity();
+        }
+    }
+
+    // Last resort of retire(): a value readers may still copy is leaked, never freed under them
+    static void leak(std::shared_ptr<ValueType>&& ptr) noexcept {
+        alignas(std::shared_ptr<ValueType>) std::byte sink[sizeof(std::shared_ptr<ValueType>)];
+        new (sink) std::shared_ptr<ValueType>(std::move(ptr));     // Never destroyed: the count is never dropped
+    }
+
+    // key: KeyType or a map key slot. Never throws: an event that can't be allocated
+    // (string key copy, queue growth) is dropped and counted by lost_removals()
+    template <typename K>
+    void note_removal(const K& key, const std::shared_ptr<ValueType>& ptr, RemovalReason reason) noexcept {
+        if (!_listener || !ptr) [[likely]] return;
+        try {
+            if constexpr (std::is_same_v<K, KeyType>) {
+                _removals.push_back({key, ptr, reason});
+            } else {
+                _removals.push_back({key.load(), ptr, reason});
             }
+        } catch (...) {
+            _lost_removals++;
+        }
+    }
+
+    auto retirer(RemovalReason reason) noexcept {
+        return [this, reason](const auto& key_slot, std::shared_ptr<ValueType>&& ptr) noexcept {
+            note_removal(key_slot, ptr, reason);
+            retire(std::move(ptr));
+        };
+    }
+
+    // Under lock: the queue is handed over once a batch is collected
+    PendingRemovals take_removals(bool force = false) {
+        if (_removals.empty() || (!force && _removals.size() < _listener->batch)) [[likely]] return {};
+
+        PendingRemovals pending{{}, _listener};
+        pending.events.swap(_removals);
+        return pending;
+    }
+
+    // After unlock
+    static void deliver_removals(PendingRemovals&& pending) {
+        if (pending.events.empty()) [[likely]] return;
+
+        auto listener = std::move(pending.listener);
+        if (!listener->executor) {
+            listener->on_removal(pending.events);
+            return;
         }
+        listener->executor([listener, events = std::move(pending.events)]() { listener->on_removal(events); });
     }
 
     void cleanup_retired() {
@@ -2151,83 +4148,232 @@ private:
         });
     }
 
-    static void spin_wait(std::atomic_flag& lock) noexcept {
-        uint32_t spin_count = 0;
-        constexpr uint32_t MAX_SPIN = 2048;
-
-        while (lock.test_and_set(std::memory_order_acquire)) {
-            if (++spin_count < MAX_SPIN) [[likely]] {
-                __builtin_ia32_pause(); 
-            } else {
-                std::this_thread::yield();
-                spin_count = 0;
-            }
+    // Returns the amount of spins: contention signal for adapt_recency()
+    uint32_t acquire_lock() noexcept {
+        if constexpr (std::convertible_to<decltype(_lock.lock()), uint32_t>) {
+            return _lock.lock();
+        } else {
+            _lock.lock();
+            return 0;
         }
     }
 
-    static void release_lock(std::atomic_flag& lock) noexcept {
-        lock.clear(std::memory_order_release);
-    }
-
      //Insert or update path (eviction is included)
      //CRITICAL section!
-    void commit_put(const KeyType& key, std::shared_ptr<ValueType>&& new_ptr) noexcept {
+    template <typename K>
+    static std::size_t hash_of(const K& key) noexcept {
+        return typename key_traits<KeyType>::hasher{}(key);
+    }
+
+    void commit_put(const KeyType& key, std::shared_ptr<ValueType>&& new_ptr, float cost = 1.0f) noexcept {
+        if (!_absent.empty()) [[unlikely]] {
+            _absent.erase(hash_of(key));    // Before the value shows up
+            _absent.expire(1);
+        }
+
         auto final_res = _collection.lookup(key);
 
         if (final_res.ptr) [[likely]] {
             // Update
             auto old = _collection.update_slot(final_res.idx, std::move(new_ptr));
-            _retired_list.push_back({std::move(old), this->current_epoch()});
+            note_removal(key, old, RemovalReason::Replaced);
+            retire(std::move(old));
+            _collection.reprice(final_res.idx, cost);
+            _collection.move_to_front(final_res.idx);
         } else {
             // Insert
-            if (_collection.size() >= Capacity) [[unlikely]] {
-                auto tail_idx = _collection.get_tail();
-                auto evicted_ptr = _collection.get_data(tail_idx).value;
+            if (!_collection.reserve_key(key)) [[unlikely]] return; // Out of key memory: the put is dropped
+
+            const auto admission = _collection.admit(key, cost);
 
-                _retired_list.push_back({std::move(evicted_ptr), this->current_epoch()});
-                _collection.erase_index(tail_idx);
+            if (_collection.size() >= Capacity) [[unlikely]] {
+                auto victim_idx = _collection.victim(admission);
+                auto evicted_ptr = _collection.get_data(victim_idx).value;
+                note_removal(_collection.get_meta(victim_idx).key, evicted_ptr, RemovalReason::Evicted);
+                retire(std::move(evicted_ptr));
+                _collection.erase_index(victim_idx);
                 final_res.idx = _collection.assign_slot(key);
             }
 
-            _collection.emplace_at(final_res.idx, key, std::move(new_ptr));
+            _collection.reclaim_stale(final_res.idx, retirer(RemovalReason::Cleared)); // Left by clear()
+            _collection.emplace_at(final_res.idx, key, std::move(new_ptr), admission);
+        }
+    }
+
+    // Feed ingestion: one epoch bump per batch instead of per item
+    // Not atomic with respect to other writers: a read-only hold spots the quiet updates, values are
+    // allocated unlocked, then one hold applies every item. A writer may run between the two holds,
+    // never between two items; quiet updates are rechecked, so the batch still wins over it
+    template <typename Item>
+    void put_batch(std::span<const Item> items) {
+        std::vector<uint8_t> quiet(items.size(), 0);
+
+        acquire_lock();
+            for (std::size_t i = 0; i < items.size(); ++i) {
+                const auto& [key, value] = batch::deref(items[i]);
+                auto res = _collection.lookup(key);
+                quiet[i] = res.ptr && *res.ptr == value;
+            }
+        _lock.unlock();
+
+        std::vector<std::shared_ptr<ValueType>> values(items.size());
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            if (!quiet[i]) {
+                values[i] = std::allocate_shared<ValueType>(HugePagesAllocator<ValueType>{}, batch::deref(items[i]).second);
+            }
         }
 
-        _collection.move_to_front(final_res.idx);
+        const uint32_t spins = acquire_lock();
+            this->bump_epoch();
+
+            if (_dirty_mask.load(std::memory_order_relaxed)) {
+                apply_updates();
+            }
+
+            for (std::size_t i = 0; i < items.size(); ++i) {
+                const auto& [key, value] = batch::deref(items[i]);
+
+                if (quiet[i]) {
+                    auto res = _collection.lookup(key);
+                    if (res.ptr && *res.ptr == value) [[likely]] {
+                        _collection.move_to_front(res.idx);
+                        continue;
+                    }
+                    // Changed by an earlier item or by a put() in between
+                    values[i] = std::allocate_shared<ValueType>(HugePagesAllocator<ValueType>{}, value);
+                }
+
+                commit_put(key, std::move(values[i]));
+            }
+            _collection.sweep(SweepBudget * items.size(), retirer(RemovalReason::Cleared));
+            adapt_recency(spins);
+
+            if (_retired_list.size() >= 64) {
+                this->cleanup_retired();
+            }
+
+            auto removals = take_removals();
+        _lock.unlock();
+
+        deliver_removals(std::move(removals));
     }
 
 public:
 
-    std::shared_ptr<ValueType> get(const KeyType& key) noexcept {
+    std::shared_ptr<ValueType> get(const KeyType& key) noexcept { return get<KeyType>(key); }
+
+    // Lookup by a view of the key: no temporary KeyType on the read path
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    std::shared_ptr<ValueType> get(const K& key) noexcept {
+        return get_ref(key).ptr;
+    }
+
+    // A hit with the slot & gen it came from: NearCache checks them later with is_current()
+    struct SlotRef {
+        std::shared_ptr<ValueType> ptr;
+        uint32_t idx = 0;
+        uint32_t gen = 0;
+    };
+
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    SlotRef get_ref(const K& key) noexcept {
         const auto tid = get_thread_id();
+        if (tid == NoSlot) [[unlikely]] return get_ref_locked(key);
         auto guard = this->enter_epoch(tid);
 
         // shared_ptr copied
         auto res = _collection.get_lockless(key); //NOTE it needs to prove
-        if (!res.ptr) [[unlikely]] return nullptr;
+        if (!res.ptr) [[unlikely]] return {};
 
         mark_access(res.idx, res.gen);
         sizes::prefetch(res.ptr.get(), 0);
 
-        return std::move(res.ptr);
+        return {std::move(res.ptr), res.idx, res.gen};
     }
 
-    template <typename T>
-    void put(const KeyType& key, T&& value) {
-
-        //CRITICAL  ****    Potential problem if user calls yield
-        //NOTE      ****    Use mutex, instead of spin
-        //std::lock_guard<std::mutex> lock(_mtx);
-        spin_wait(_spin_lock);
+    // No epoch slot left: the lock keeps the value alive while the pointer is copied
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    SlotRef get_ref_locked(const K& key) noexcept {
+        acquire_lock();
             auto res = _collection.lookup(key);
+            if (res.ptr) _collection.move_to_front(res.idx);
+        _lock.unlock();
 
-            if (res.ptr) [[likely]] { // Quiet Update
-                if (*res.ptr == value) [[likely]] {
-                    _collection.move_to_front(res.idx);
-                     release_lock(_spin_lock);
-                    return;
-                }
-            }
-        release_lock(_spin_lock);
+        if (!res.ptr) return {};
+        return {std::move(res.ptr), res.idx, res.gen};
+    }
+
+    struct Lookup {
+        std::shared_ptr<ValueType> ptr;
+        Presence presence = Presence::Miss;
+    };
+
+    // get() that tells a plain miss from a key the backend has no value for
+    // The filter is probed after the table misses: hits never pay for it
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    Lookup lookup(const K& key) noexcept {
+        if (auto ref = get_ref(key); ref.ptr) [[likely]] return {std::move(ref.ptr), Presence::Hit};
+        if (!_absent.empty() && _absent.contains(hash_of(key))) return {nullptr, Presence::Absent};
+        return {};
+    }
+
+    // The backend has no value for the key: lookups answer Absent for ttl, a put() of the key ends it
+    void put_absent(const KeyType& key, std::chrono::nanoseconds ttl = AbsentTtl) {
+        acquire_lock();
+            if (!_collection.lookup(key).ptr) {
+                _absent.insert(hash_of(key), std::chrono::duration_cast<typename Absent::clock::duration>(ttl));
+            }
+        _lock.unlock();
+    }
+
+    // Live entries, stale slots of a cleared era don't count
+    std::size_t size() {
+        acquire_lock();
+            const std::size_t n = _collection.size();
+        _lock.unlock();
+        return n;
+    }
+
+    std::size_t absent_size() const noexcept { return _absent.size(); }
+
+    // Removal events dropped because they couldn't be allocated
+    std::size_t lost_removals() {
+        acquire_lock();
+            const std::size_t n = _lost_removals;
+        _lock.unlock();
+        return n;
+    }
+
+    // Lockless: the slot still holds the same key & value
+    bool is_current(uint32_t idx, uint32_t gen) const noexcept {
+        return _collection.is_valid_gen(static_cast<cacheMap::index_type>(idx), gen);
+    }
+
+    // A hit served outside of get()
+    void touch(uint32_t idx, uint32_t gen) noexcept {
+        mark_access(static_cast<cacheMap::index_type>(idx), gen);
+    }
+
+    // cost: price of a miss (recompute time, bytes...), only GDSF uses it
+    template <typename T>
+    void put(const KeyType& key, T&& value, float cost = 1.0f) {
+        const uint32_t quiet_spins = acquire_lock();
+            auto res = _collection.lookup(key);
+
+            if (res.ptr) [[likely]] { // Quiet Update
+                if (*res.ptr == value) [[likely]] {
+                    _collection.reprice(res.idx, cost);
+                    _collection.move_to_front(res.idx);
+                    adapt_recency(quiet_spins);     // A write too: re-put-only shards must adapt as well
+                    _lock.unlock();
+                    return;
+                }
+            }
+        _lock.unlock();
 
 //        auto new_ptr = std::make_shared<ValueType>(std::forward<T>(value));
         auto new_ptr = std::allocate_shared<ValueType>(
@@ -2235,20 +4381,223 @@ public:
             std::forward<T>(value)
         );
 
-        spin_wait(_spin_lock);
+        const uint32_t spins = acquire_lock();
             this->bump_epoch();
 
             if (_dirty_mask.load(std::memory_order_relaxed)) {
                 apply_updates();
             }
 
-            commit_put(key, std::move(new_ptr));
+            commit_put(key, std::move(new_ptr), cost);
+            _collection.sweep(SweepBudget, retirer(RemovalReason::Cleared));
+            adapt_recency(spins);
 
             if (_retired_list.size() >= 64) {
                 this->cleanup_retired();
             }
 
-        release_lock(_spin_lock);
+            auto removals = take_removals();
+        _lock.unlock();
+
+        deliver_removals(std::move(removals));
+    }
+
+    void put_many(std::span<const std::pair<KeyType, ValueType>> items) { put_batch(items); }
+    void put_many(std::span<const std::pair<KeyType, ValueType>* const> items) { put_batch(items); }
+
+    bool erase(const KeyType& key) {
+        acquire_lock();
+            this->bump_epoch();
+
+            auto res = _collection.lookup(key);
+            const bool found = res.ptr != nullptr;
+            if (found) {
+                note_removal(key, res.ptr, RemovalReason::Erased);
+                retire(std::move(res.ptr));
+                _collection.erase_index(res.idx);
+            }
+
+            auto removals = take_removals();
+        _lock.unlock();
+
+        deliver_removals(std::move(removals));
+        return found;
+    }
+
+    // pred(const KeyType&, const ValueType&), the lock is released between chunks
+    // so an invalidation burst doesn't stall writers
+    template <typename P>
+    std::size_t erase_if(P&& pred) {
+        std::size_t erased = 0;
+
+        for (std::size_t first = 0; first < slot_count(); first += EraseChunk) {
+            acquire_lock();
+                this->bump_epoch();
+                erased += _collection.erase_if(first, first + EraseChunk, pred, retirer(RemovalReason::Erased));
+
+                if (_retired_list.size() >= 64) {
+                    this->cleanup_retired();
+                }
+
+                auto removals = take_removals();
+            _lock.unlock();
+
+            deliver_removals(std::move(removals));
+        }
+        return erased;
+    }
+
+    // Old keys miss at once (era bump), then the stale slots are swept chunk by chunk with the lock
+    // released in between: values are freed and the listener gets Cleared without waiting for later puts
+    void clear() {
+        acquire_lock();
+            this->bump_epoch();
+            _collection.clear();
+            _absent.clear();
+        _lock.unlock();
+
+        for (std::size_t swept = 0; swept < slot_count(); swept += EraseChunk) {
+            acquire_lock();
+                this->bump_epoch();
+                _collection.sweep(EraseChunk, retirer(RemovalReason::Cleared));
+
+                if (_retired_list.size() >= 64) {
+                    this->cleanup_retired();
+                }
+
+                auto removals = take_removals(swept + EraseChunk >= slot_count());
+            _lock.unlock();
+
+            deliver_removals(std::move(removals));
+        }
+
+        // The last chunk's values were retired in the current epoch, a new one lets them go
+        acquire_lock();
+            this->bump_epoch();
+            this->cleanup_retired();
+        _lock.unlock();
+    }
+
+    // Empty on_removal turns the listener off, events queued for the old one are delivered to it
+    void set_removal_listener(Listener listener) {
+        auto next = listener.on_removal ? std::make_shared<const Listener>(std::move(listener)) : nullptr;
+
+        acquire_lock();
+            auto removals = take_removals(true);
+            _listener = std::move(next);
+        _lock.unlock();
+
+        deliver_removals(std::move(removals));
+    }
+
+    // Delivers a partial batch
+    void flush_removals() {
+        acquire_lock();
+            auto removals = take_removals(true);
+        _lock.unlock();
+
+        deliver_removals(std::move(removals));
+    }
+
+    RecencyMode recency_mode() const noexcept { return _recency.load(std::memory_order_relaxed); }
+    uint64_t recency_switches() const noexcept { return _recency_switches.load(std::memory_order_relaxed); }
+
+    // Fixes the recency mode, std::nullopt brings adaptation back
+    void pin_recency(std::optional<RecencyMode> mode) noexcept {
+        acquire_lock();
+            _recency_pinned = mode.has_value();
+            if (mode && *mode != recency_mode()) switch_recency(*mode);
+        _lock.unlock();
+    }
+
+    LockStats lock_stats() const noexcept requires CountingLock<Lock> { return _lock.stats(); }
+
+    // Access records lost by the readers' rings: the data for sizing them
+    TraceStats trace_stats() const noexcept {
+        TraceStats total;
+        for (const auto& buffer : _update_buffers) {
+            const auto stats = buffer.stats();
+            total.dropped += stats.dropped;
+            total.overwritten += stats.overwritten;
+        }
+        return total;
+    }
+
+    // SLRU: protected segment share of the capacity, 0.8 by default
+    void set_protected_share(double share) noexcept requires (Policy == EvictionPolicy::SLRU) {
+        acquire_lock();
+            _collection.set_protected_share(share);
+        _lock.unlock();
+    }
+
+    static constexpr std::size_t slot_count() noexcept { return cacheMap::slot_count(); }
+
+    // Lockless enumeration under an epoch guard: the put path is never stalled
+    // Visitor: (const KeyType&, const std::shared_ptr<ValueType>&)
+    // Chunks of [0, slot_count()) can be scanned by different threads
+    template <typename F>
+    std::size_t scan(std::size_t first, std::size_t last, F&& visitor) {
+        const auto tid = get_thread_id();
+        if (tid == NoSlot) [[unlikely]] {   // No epoch slot left: the chunk is copied under the lock
+            std::vector<std::pair<KeyType, std::shared_ptr<ValueType>>> copied;
+            acquire_lock();
+                _collection.scan(first, last, [&copied](const KeyType& key, const auto& ptr) {
+                    copied.emplace_back(key, ptr);
+                });
+            _lock.unlock();
+
+            for (const auto& [key, ptr] : copied) visitor(key, ptr);
+            return copied.size();
+        }
+
+        auto guard = this->enter_epoch(tid);
+        return _collection.scan(first, last, visitor);
+    }
+
+    template <typename F>
+    std::size_t for_each(F&& visitor) {
+        return scan(0, slot_count(), std::forward<F>(visitor));
+    }
+
+    // Warm restart: (key, value) pairs from cold to hot
+    // Values are pinned by shared_ptr, so the lock is held only for the list walk
+    std::vector<std::pair<KeyType, std::shared_ptr<ValueType>>> export_lru() {
+        std::vector<std::pair<KeyType, std::shared_ptr<ValueType>>> out;
+        out.reserve(Capacity);
+
+        acquire_lock();
+            _collection.for_each_from_tail([&out](const KeyType& key, const auto& ptr) {
+                out.emplace_back(key, ptr);
+            });
+        _lock.unlock();
+
+        return out;
+    }
+
+    // Records are in cold to hot order: the hottest ones end up at the head
+    std::size_t import_lru(std::span<const snapshot::Record<KeyType, ValueType>> records)
+    requires snapshot::Trivial<KeyType> && snapshot::Trivial<ValueType> {
+        if (records.size() > Capacity) {
+            records = records.last(Capacity); // The coldest ones would be evicted anyway
+        }
+
+        std::vector<std::shared_ptr<ValueType>> values;
+        values.reserve(records.size());
+        for (const auto& record : records) {
+            values.push_back(std::allocate_shared<ValueType>(HugePagesAllocator<ValueType>{}, record.value));
+        }
+
+        acquire_lock();
+            this->bump_epoch();
+
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                commit_put(records[i].key, std::move(values[i]));
+            }
+
+            this->cleanup_retired();
+        _lock.unlock();
+
+        return records.size();
     }
 
 private:
@@ -2256,19 +4605,166 @@ private:
     alignas(CacheLine) std::atomic<uint64_t>    _dirty_mask{0};
     std::vector<RetiredObject> _retired_list;
 
+    std::vector<RemovalEvent<KeyType, ValueType>>   _removals;
+    std::shared_ptr<const Listener>                 _listener;
+    std::size_t                                     _lost_removals = 0;     // Events dropped out of memory
+
+    // Contention stats of the current window, under lock except _contended
+    alignas(CacheLine) std::atomic<RecencyMode> _recency{RecencyMode::Deferred};   // Read by every get()
+    alignas(CacheLine) std::atomic<uint64_t>    _contended{0};  // Busy lock in strict mode
+    uint64_t                    _window_spins = 0;
+    uint32_t                    _window_writes = 0;
+    uint32_t                    _window_full_drains = 0;
+    uint32_t                    _quiet_windows = 0;
+    std::atomic<uint64_t>       _recency_switches{0};  // Writer under lock, anyone reads
+    bool                        _recency_pinned = false;
+
     cacheMap            _collection;
+    Absent              _absent;
+    Lock                _lock;
+};
+
+/*  Per-thread L1 in front of Lv3_ShardedCache: a hot key costs no hash, probe, epoch or refcount traffic
+*   An entry remembers the shard, slot and gen its value came from: any update, eviction or clear moves
+*   the slot gen, so a stale entry fails validation and nothing is broadcast to the threads
+*   Keys are compared all at once (AVX2 for 4 & 8 byte integers), CLOCK replacement
+*   Doorkeeper: a key gets in on its second far hit, one-off reads don't flush the hot ones
+*/
+template <typename KeyType, typename ValueType, std::size_t Entries>
+requires PowerOfTwoValue<Entries>
+class NearCache : private NonCopyableNonMoveable {
+    static_assert(Entries >= 8 && Entries <= 32, "NearCache holds 8-32 entries");
+    static constexpr bool SimdKeys = std::is_integral_v<KeyType> && (sizeof(KeyType) == 4 || sizeof(KeyType) == 8);
+    static constexpr uint8_t TouchEvery = 16;      // Near hits per recency note to the shard
+    static constexpr std::size_t DoorSlots = 4 * Entries;
+
+    using Mask = std::conditional_t<(Entries <= 16), uint16_t, uint32_t>;
+
+    Mask match(const KeyType& key) const noexcept {
+        uint32_t found = 0;
+#ifdef __AVX2__
+        if constexpr (SimdKeys && sizeof(KeyType) == 4) {
+            const __m256i needle = _mm256_set1_epi32(static_cast<int32_t>(key));
+            for (std::size_t i = 0; i < Entries; i += 8) {
+                const __m256i keys = _mm256_load_si256(reinterpret_cast<const __m256i*>(&_keys[i]));
+                found |= static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(keys, needle)))) << i;
+            }
+            return static_cast<Mask>(found) & _occupied;
+        } else if constexpr (SimdKeys) {
+            const __m256i needle = _mm256_set1_epi64x(static_cast<int64_t>(key));
+            for (std::size_t i = 0; i < Entries; i += 4) {
+                const __m256i keys = _mm256_load_si256(reinterpret_cast<const __m256i*>(&_keys[i]));
+                found |= static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(keys, needle)))) << i;
+            }
+            return static_cast<Mask>(found) & _occupied;
+        }
+#endif
+        for (std::size_t i = 0; i < Entries; ++i) {
+            found |= static_cast<uint32_t>(typename key_traits<KeyType>::key_equal{}(_keys[i], key)) << i;
+        }
+        return static_cast<Mask>(found) & _occupied;
+    }
 
-    //CRITICAL  ****    Potential problem if user calls yield
-    //NOTE      ****    Use mutex, instead of spin
-    std::atomic_flag    _spin_lock = ATOMIC_FLAG_INIT;
-    //std::mutex          _mtx;
+public:
+    struct Ref {
+        uint32_t shard;
+        uint32_t slot;
+        uint32_t gen;
+    };
+
+    static uint64_t next_owner() noexcept {
+        static std::atomic<uint64_t> owners{0};
+        return owners.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // A read() visitor holds one of the values: reset(), drop() and insert() must wait
+    struct [[nodiscard]] Pin {
+        NearCache* cache;
+        ~Pin() { cache->_pinned = false; }
+    };
+
+    Pin pin() noexcept {
+        _pinned = true;
+        return {this};
+    }
+
+    bool pinned() const noexcept { return _pinned; }
+
+    void reset() noexcept {
+        for (auto& value : _values) value.reset();
+        _door.fill(0);
+        _occupied = 0;
+        _referenced = 0;
+        _hand = 0;
+    }
+
+    // Position of the key or -1
+    int find(const KeyType& key) const noexcept {
+        const Mask found = match(key);
+        return found ? std::countr_zero(found) : -1;
+    }
+
+    const Ref& ref(int pos) const noexcept { return _refs[pos]; }
+    const std::shared_ptr<ValueType>& value(int pos) const noexcept { return _values[pos]; }
+
+    // Returns true when the shard should hear about the hit
+    bool hit(int pos) noexcept {
+        _referenced |= Mask(1) << pos;
+        return ++_hits[pos] % TouchEvery == 0;
+    }
+
+    void drop(int pos) noexcept {
+        _occupied &= ~(Mask(1) << pos);
+        _values[pos].reset();
+    }
+
+    // CLOCK: referenced entries get another round
+    void insert(const KeyType& key, const Ref& ref, std::shared_ptr<ValueType> value) noexcept {
+        int pos = find(key);
+        if (pos < 0) {
+            // Direct-mapped fingerprints of the last far hits
+            const uint64_t mixed = (typename key_traits<KeyType>::hasher{}(key) | 1) * 0x9E3779B97F4A7C15ULL;
+            auto& door = _door[(mixed >> 32) & (DoorSlots - 1)];
+            const uint32_t tag = static_cast<uint32_t>(mixed);
+            if (door != tag) {
+                door = tag;
+                return;
+            }
+
+            while (_referenced & (Mask(1) << _hand)) {
+                _referenced &= ~(Mask(1) << _hand);
+                _hand = (_hand + 1) & (Entries - 1);
+            }
+            pos = static_cast<int>(_hand);
+            _hand = (_hand + 1) & (Entries - 1);
+        }
+
+        _keys[pos] = key;
+        _refs[pos] = ref;
+        _values[pos] = std::move(value);
+        _hits[pos] = 0;
+        _occupied |= Mask(1) << pos;
+    }
+
+private:
+    alignas(sizes::CacheLine) std::array<KeyType, Entries>  _keys{};
+    Mask                                                    _occupied = 0;
+    Mask                                                    _referenced = 0;
+    uint32_t                                                _hand = 0;
+    bool                                                    _pinned = false;
+    std::array<Ref, Entries>                                _refs{};
+    std::array<uint8_t, Entries>                            _hits{};
+    std::array<std::shared_ptr<ValueType>, Entries>         _values;
+    std::array<uint32_t, DoorSlots>                         _door{};
 };
 
 //  Wrapper for SharedLRU
+//  NearEntries > 0: per-thread NearCache of that size in front of the shards
 template <template<typename, typename, std::size_t> class CacheImpl,
     typename KeyType, typename ValueType,
     std::size_t TotalCapacity = 2 * 1024,
-    std::size_t ShardsCount = 16>
+    std::size_t ShardsCount = 16,
+    std::size_t NearEntries = 0>
 requires PowerOfTwoValue<ShardsCount>
 class Lv3_ShardedCache : private NonCopyableNonMoveable {
     static constexpr std::size_t CacheLine = sizes::CacheLine;
@@ -2278,6 +4774,9 @@ class Lv3_ShardedCache : private NonCopyableNonMoveable {
 
 public:
     static constexpr std::string name() noexcept {
+        if constexpr (NearEntries > 0) {
+            return "Lv3_Sharded<" + std::string(Cache::name()) + "> + Near" + std::to_string(NearEntries);
+        }
         return "Lv3_Sharded<" + std::string(Cache::name()) + ">";
     }
 
@@ -2291,8 +4790,63 @@ private:
     static_assert(std::has_single_bit(ShardsCount), "ShardsCount must be power of 2");
     static_assert(std::has_single_bit(alignof(Cache)), "Alignment must be power of 2");
 
-    std::size_t get_shard_idx(const KeyType& key) const noexcept {
-        return std::hash<KeyType>{}(key) & Mask;
+    template <typename K>
+    std::size_t get_shard_idx(const K& key) const noexcept {
+        return typename key_traits<KeyType>::hasher{}(key) & Mask;
+    }
+
+    using Near = NearCache<KeyType, ValueType, std::max<std::size_t>(NearEntries, 8)>;
+    static constexpr std::size_t NearPerThread = 4;     // Instances of the type with their own L1 in a thread
+
+    struct NearSet {
+        std::array<uint64_t, NearPerThread> owners{};   // One line per get(), the L1s themselves stay cold
+        std::size_t                         victim = 0;
+        std::array<Near, NearPerThread>     caches;
+    };
+
+    // This instance's L1 in the calling thread, taken over round-robin
+    // nullptr: pinned by a read() up the stack, the caller goes to the shards
+    Near* near() noexcept {
+        thread_local NearSet set;
+        for (std::size_t i = 0; i < NearPerThread; ++i) {
+            if (set.owners[i] == _near_owner) [[likely]] return set.caches[i].pinned() ? nullptr : &set.caches[i];
+        }
+
+        for (std::size_t i = 0; i < NearPerThread; ++i) {
+            const std::size_t idx = (set.victim + i) % NearPerThread;
+            if (set.caches[idx].pinned()) continue;
+
+            set.victim = (idx + 1) % NearPerThread;
+            set.caches[idx].reset();
+            set.owners[idx] = _near_owner;
+            return &set.caches[idx];
+        }
+        return nullptr;
+    }
+
+    // Valid hit: the value without touching the shard's table, epoch or refcount
+    const std::shared_ptr<ValueType>* near_get(Near& cache, const KeyType& key) noexcept {
+        const int pos = cache.find(key);
+        if (pos < 0) return nullptr;
+
+        const auto& ref = cache.ref(pos);
+        auto& shard = *_shards[ref.shard].cache;
+        if (!shard.is_current(ref.slot, ref.gen)) [[unlikely]] {
+            cache.drop(pos);
+            return nullptr;
+        }
+
+        if (cache.hit(pos)) shard.touch(ref.slot, ref.gen); // The shard's LRU still sees hot keys
+        return &cache.value(pos);
+    }
+
+    std::shared_ptr<ValueType> far_get(Near& cache, const KeyType& key) noexcept {
+        const std::size_t shard_idx = get_shard_idx(key);
+        auto res = _shards[shard_idx].cache->get_ref(key);
+        if (res.ptr) {
+            cache.insert(key, {static_cast<uint32_t>(shard_idx), res.idx, res.gen}, res.ptr);
+        }
+        return std::move(res.ptr);
     }
 
 public:
@@ -2303,19 +4857,521 @@ public:
         }
     }
 
-    std::shared_ptr<ValueType> get(const KeyType& key) noexcept {
+    std::shared_ptr<ValueType> get(const KeyType& key) noexcept { return get<KeyType>(key); }
+
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    std::shared_ptr<ValueType> get(const K& key) noexcept {
+        if constexpr (NearEntries > 0 && std::same_as<K, KeyType>) {
+            if (auto* cache = near()) [[likely]] {
+                if (const auto* ptr = near_get(*cache, key)) [[likely]] return *ptr;
+                return far_get(*cache, key);
+            }
+        }
         return _shards[get_shard_idx(key)].cache->get(key);
     }
 
+    // visitor(const ValueType&) on a hit, a near hit doesn't copy the shared_ptr
+    // The L1 is pinned meanwhile: get() / read() from the visitor bypass it and can't free the value
+    template <typename F>
+    bool read(const KeyType& key, F&& visitor) {
+        if constexpr (NearEntries > 0) {
+            if (auto* cache = near()) [[likely]] {
+                if (const auto* ptr = near_get(*cache, key)) [[likely]] {
+                    const auto pin = cache->pin();
+                    visitor(std::as_const(**ptr));
+                    return true;
+                }
+                const auto ptr = far_get(*cache, key);
+                if (ptr) visitor(std::as_const(*ptr));
+                return ptr != nullptr;
+            }
+        }
+        const auto ptr = _shards[get_shard_idx(key)].cache->get(key);
+        if (ptr) visitor(std::as_const(*ptr));
+        return ptr != nullptr;
+    }
+
     template <typename T>
     void put(const KeyType& key, T&& value) {
         _shards[get_shard_idx(key)].cache->put(key, std::forward<T>(value));
     }
 
+    template <typename T>
+    void put(const KeyType& key, T&& value, float cost) {
+        _shards[get_shard_idx(key)].cache->put(key, std::forward<T>(value), cost);
+    }
+
+    // Hit / Miss / Absent from the key's shard, the near cache is skipped
+    template <typename K>
+    requires LookupKeyFor<KeyType, K>
+    auto lookup(const K& key) noexcept {
+        return _shards[get_shard_idx(key)].cache->lookup(key);
+    }
+
+    void put_absent(const KeyType& key) {
+        _shards[get_shard_idx(key)].cache->put_absent(key);
+    }
+
+    void put_absent(const KeyType& key, std::chrono::nanoseconds ttl) {
+        _shards[get_shard_idx(key)].cache->put_absent(key, ttl);
+    }
+
+    std::size_t absent_size() const noexcept {
+        std::size_t total = 0;
+        for (const auto& shard : _shards) total += shard.cache->absent_size();
+        return total;
+    }
+
+    std::size_t lost_removals() {
+        std::size_t total = 0;
+        for (auto& shard : _shards) total += shard.cache->lost_removals();
+        return total;
+    }
+
+    // Grouped by shard: one commit hold (and one epoch bump) per touched shard, shards one after another
+    void put_many(std::span<const std::pair<KeyType, ValueType>> items) {
+        std::array<std::vector<const std::pair<KeyType, ValueType>*>, ShardsCount> groups;
+        for (const auto& item : items) {
+            groups[get_shard_idx(item.first)].push_back(&item);
+        }
+
+        for (std::size_t i = 0; i < ShardsCount; ++i) {
+            if (groups[i].empty()) continue;
+            _shards[i].cache->put_many(std::span<const std::pair<KeyType, ValueType>* const>(groups[i]));
+        }
+    }
+
+    bool erase(const KeyType& key) {
+        return _shards[get_shard_idx(key)].cache->erase(key);
+    }
+
+    template <typename P>
+    std::size_t erase_if(P&& pred) {
+        std::size_t erased = 0;
+        for (auto& shard : _shards) erased += shard.cache->erase_if(pred);
+        return erased;
+    }
+
+    void clear() {
+        for (auto& shard : _shards) shard.cache->clear();
+    }
+
+    std::size_t size() {
+        std::size_t total = 0;
+        for (auto& shard : _shards) total += shard.cache->size();
+        return total;
+    }
+
+    // Every shard queues its own events, the listener must be thread-safe
+    void set_removal_listener(const RemovalListener<KeyType, ValueType>& listener) {
+        for (auto& shard : _shards) shard.cache->set_removal_listener(listener);
+    }
+
+    void flush_removals() {
+        for (auto& shard : _shards) shard.cache->flush_removals();
+    }
+
+    std::size_t strict_shards() const noexcept {
+        return std::count_if(_shards.begin(), _shards.end(), [](const auto& shard) {
+            return shard.cache->recency_mode() == RecencyMode::Strict;
+        });
+    }
+
+    uint64_t recency_switches() const noexcept {
+        uint64_t total = 0;
+        for (const auto& shard : _shards) total += shard.cache->recency_switches();
+        return total;
+    }
+
+    void pin_recency(std::optional<RecencyMode> mode) noexcept {
+        for (auto& shard : _shards) shard.cache->pin_recency(mode);
+    }
+
+    void set_protected_share(double share) noexcept requires requires(Cache& c) { c.set_protected_share(share); } {
+        for (auto& shard : _shards) shard.cache->set_protected_share(share);
+    }
+
+    // Sum over the shards' writer locks
+    LockStats lock_stats() const noexcept requires requires(const Cache& c) { c.lock_stats(); } {
+        LockStats total;
+        for (const auto& shard : _shards) {
+            const auto stats = shard.cache->lock_stats();
+            total.acquisitions += stats.acquisitions;
+            total.spins += stats.spins;
+            total.parks += stats.parks;
+        }
+        return total;
+    }
+
+    TraceStats trace_stats() const noexcept requires requires(const Cache& c) { c.trace_stats(); } {
+        TraceStats total;
+        for (const auto& shard : _shards) {
+            const auto stats = shard.cache->trace_stats();
+            total.dropped += stats.dropped;
+            total.overwritten += stats.overwritten;
+        }
+        return total;
+    }
+
+    template <typename F>
+    std::size_t for_each(F&& visitor) {
+        std::size_t visited = 0;
+        for (auto& shard : _shards) {
+            visited += shard.cache->for_each(visitor);
+        }
+        return visited;
+    }
+
+    // Workers pull (shard, chunk) tasks, visitor must be thread-safe
+    template <typename F>
+    std::size_t parallel_for_each(F&& visitor, unsigned threads = std::thread::hardware_concurrency(),
+                                  std::size_t chunk = 1024) {
+        const std::size_t slots = Cache::slot_count();
+        chunk = std::clamp<std::size_t>(chunk, 1, slots);
+        const std::size_t chunks_per_shard = (slots + chunk - 1) / chunk;
+        const std::size_t total = ShardsCount * chunks_per_shard;
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> visited{0};
+
+        auto worker = [&]() {
+            std::size_t local = 0;
+            for (std::size_t task = next.fetch_add(1, std::memory_order_relaxed); task < total;
+                 task = next.fetch_add(1, std::memory_order_relaxed)) {
+                const std::size_t first = (task % chunks_per_shard) * chunk;
+                local += _shards[task / chunks_per_shard].cache->scan(first, first + chunk, visitor);
+            }
+            visited.fetch_add(local, std::memory_order_relaxed);
+        };
+
+        threads = std::clamp<unsigned>(threads, 1, total);
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back(worker);
+        }
+        worker(); // Caller is a worker too
+        for (auto& w : workers) w.join();
+
+        return visited.load(std::memory_order_relaxed);
+    }
+
+    // Shards are exported one by one: each of them is locked only for its list walk
+    bool save_snapshot(const std::string& path)
+    requires snapshot::Trivial<KeyType> && snapshot::Trivial<ValueType> {
+        using Record = snapshot::Record<KeyType, ValueType>;
+        using snapshot::PageSize;
+
+        std::vector<std::vector<std::pair<KeyType, std::shared_ptr<ValueType>>>> lists;
+        lists.reserve(ShardsCount);
+        for (auto& shard : _shards) {
+            lists.push_back(shard.cache->export_lru());
+        }
+
+        const snapshot::Header header{
+            snapshot::Magic, snapshot::Version, ShardsCount, ShardCapacity,
+            sizeof(KeyType), sizeof(ValueType), sizeof(Record), alignof(Record)
+        };
+
+        std::vector<snapshot::ShardIndex> index(ShardsCount);
+        uint64_t offset = sizes::align_up<PageSize>(sizeof(header) + sizeof(snapshot::ShardIndex) * ShardsCount);
+        for (std::size_t i = 0; i < ShardsCount; ++i) {
+            index[i] = {offset, lists[i].size()};
+            offset = sizes::align_up<PageSize>(offset + lists[i].size() * sizeof(Record));
+        }
+
+        snapshot::Writer out(path);
+        out.write(&header, sizeof(header));
+        out.write(index.data(), index.size() * sizeof(snapshot::ShardIndex));
+
+        for (const auto& list : lists) {
+            out.pad_to(PageSize);
+            for (const auto& [key, ptr] : list) { // Same layout as Record
+                out.write(&key, sizeof(KeyType));
+                out.pad_to(alignof(ValueType));
+                out.write(ptr.get(), sizeof(ValueType));
+                out.pad_to(alignof(Record));
+            }
+        }
+
+        return out.finish();
+    }
+
+    // Returns the amount of restored entries, 0 if the snapshot doesn't match this cache
+    std::size_t load_snapshot(const std::string& path, unsigned threads = std::thread::hardware_concurrency())
+    requires snapshot::Trivial<KeyType> && snapshot::Trivial<ValueType> {
+        using Record = snapshot::Record<KeyType, ValueType>;
+
+        snapshot::MappedFile file(path);
+        if (!file.valid() || file.size() < sizeof(snapshot::Header)) return 0;
+
+        snapshot::Header header;
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (header.magic != snapshot::Magic || header.version != snapshot::Version ||
+            header.shards != ShardsCount || header.shard_capacity != ShardCapacity ||
+            header.key_size != sizeof(KeyType) || header.value_size != sizeof(ValueType) ||
+            header.record_size != sizeof(Record) || header.record_align != alignof(Record)) {
+            return 0;
+        }
+
+        if (file.size() < sizeof(header) + ShardsCount * sizeof(snapshot::ShardIndex)) return 0;
+
+        std::vector<snapshot::ShardIndex> index(ShardsCount);
+        std::memcpy(index.data(), file.data() + sizeof(header), index.size() * sizeof(snapshot::ShardIndex));
+
+        for (const auto& section : index) {
+            // File-controlled values: no arithmetic that can wrap
+            if (section.offset % alignof(Record) != 0 || section.offset > file.size() ||
+                section.count > (file.size() - section.offset) / sizeof(Record)) {
+                return 0;
+            }
+        }
+
+        std::atomic<std::size_t> restored{0};
+        threads = std::clamp<unsigned>(threads, 1, ShardsCount);
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                for (std::size_t i = t; i < ShardsCount; i += threads) {
+                    const auto* first = reinterpret_cast<const Record*>(file.data() + index[i].offset);
+                    auto n = _shards[i].cache->import_lru({first, index[i].count});
+                    restored.fetch_add(n, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        return restored.load(std::memory_order_relaxed);
+    }
+
 private:
     struct alignas(CacheLine) ShardWrapper {
         std::unique_ptr<Cache> cache;
         explicit ShardWrapper(std::unique_ptr<Cache> c) : cache(std::move(c)) {}
     };
     std::vector<ShardWrapper> _shards;
+    uint64_t _near_owner = Near::next_owner();
+};
+
+
+template <typename Store, typename KeyType, typename ValueType>
+concept BatchStore = requires(Store& store, std::span<const std::pair<KeyType, ValueType>> batch) {
+    store.write_batch(batch);
+};
+
+/*  Write-behind layer for a slow backing store (designed for Lv3_ShardedCache)
+*   put() updates the cache and queues the key in a per-shard dirty queue
+*   Dirty queue coalesces repeated updates: only the last value per key is written
+*   Flusher thread writes batches: queue reached max_batch or the oldest record reached max_staleness
+*   Backpressure: writer waits while its dirty queue holds max_dirty records
+*/
+template <typename Cache, typename Store, std::size_t DirtyShards = 16>
+requires PowerOfTwoValue<DirtyShards> && BatchStore<Store, typename Cache::key_type, typename Cache::value_type>
+class WriteBehindCache : private NonCopyableNonMoveable {
+public:
+    static std::string name() {
+        return "WriteBehind<" + std::string(Cache::name()) + ">";
+    }
+
+    using value_type = typename Cache::value_type;
+    using key_type = typename Cache::key_type;
+    using clock = std::chrono::steady_clock;
+
+    struct Config {
+        std::size_t                 max_batch = 256;
+        std::size_t                 max_dirty = 4 * 1024;          // per shard
+        std::chrono::milliseconds   max_staleness{50};
+    };
+
+    struct Stats {
+        uint64_t puts;
+        uint64_t coalesced;     // puts absorbed by an already dirty key
+        uint64_t flushed;       // records written to the store
+        uint64_t batches;
+        uint64_t stalls;        // backpressure waits
+    };
+
+private:
+    static constexpr std::size_t CacheLine = sizes::CacheLine;
+    static constexpr std::size_t Mask = DirtyShards - 1;
+    using record = std::pair<key_type, value_type>;
+
+    struct alignas(CacheLine) DirtyShard {
+        std::mutex                                  mtx;
+        std::condition_variable                     drained;
+        std::vector<record>                         queue;
+        std::unordered_map<key_type, std::size_t>   position;   // key -> index in queue
+        clock::time_point                           oldest;
+    };
+
+    struct alignas(CacheLine) Counters {
+        std::atomic<uint64_t> puts{0};
+        std::atomic<uint64_t> coalesced{0};
+        std::atomic<uint64_t> flushed{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> stalls{0};
+    };
+
+    std::size_t get_shard_idx(const key_type& key) const noexcept {
+        return typename key_traits<key_type>::hasher{}(key) & Mask;
+    }
+
+    void wake_flusher() {
+        {
+            std::lock_guard lock(_wake_mtx);
+            _wake = true;
+        }
+        _wake_cv.notify_one();
+    }
+
+    bool is_due(const DirtyShard& shard, clock::time_point now, bool force) const noexcept {
+        if (shard.queue.empty()) return false;
+        return force || shard.queue.size() >= std::min(_config.max_batch, _config.max_dirty)
+                     || now - shard.oldest >= _config.max_staleness;
+    }
+
+    void write_out(std::vector<record>& batch) {
+        for (std::size_t offset = 0; offset < batch.size(); offset += _config.max_batch) {
+            const std::size_t n = std::min(_config.max_batch, batch.size() - offset);
+            _store.write_batch(std::span<const record>(batch.data() + offset, n));
+            _counters.batches.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        _counters.flushed.fetch_add(batch.size(), std::memory_order_relaxed);
+        batch.clear();
+    }
+
+    // Only one flush pass at a time: keeps the writes of the same key ordered
+    void flush_pass(bool force) {
+        std::lock_guard flush_lock(_flush_mtx);
+        const auto now = clock::now();
+
+        for (auto& shard : _dirty) {
+            {
+                std::lock_guard lock(shard.mtx);
+                if (!is_due(shard, now, force)) continue;
+
+                shard.queue.swap(_scratch);
+                shard.position.clear();
+            }
+            shard.drained.notify_all();
+
+            write_out(_scratch);
+        }
+    }
+
+    void flusher_loop() {
+        const auto period = std::max(_config.max_staleness / 2, std::chrono::milliseconds(1));
+        std::unique_lock lock(_wake_mtx);
+
+        while (!_stop) {
+            _wake_cv.wait_for(lock, period, [this] { return _wake || _stop; });
+            _wake = false;
+
+            lock.unlock();
+            flush_pass(false);
+            lock.lock();
+        }
+    }
+
+public:
+    explicit WriteBehindCache(Store& store, Config config = {}) : _store(store), _config(config) {
+        for (auto& shard : _dirty) {
+            shard.queue.reserve(_config.max_batch);
+        }
+        _flusher = std::thread([this] { flusher_loop(); });
+    }
+
+    ~WriteBehindCache() {
+        {
+            std::lock_guard lock(_wake_mtx);
+            _stop = true;
+        }
+        _wake_cv.notify_one();
+        _flusher.join();
+
+        flush_pass(true); // Nothing dirty is lost on shutdown
+    }
+
+    template <typename K = key_type>
+    auto get(const K& key) noexcept {
+        return _cache.get(key);
+    }
+
+    template <typename T>
+    void put(const key_type& key, T&& value) {
+        _counters.puts.fetch_add(1, std::memory_order_relaxed);
+
+        auto& shard = _dirty[get_shard_idx(key)];
+        std::unique_lock lock(shard.mtx);
+
+        auto it = shard.position.find(key);
+        while (it == shard.position.end() && shard.queue.size() >= _config.max_dirty) [[unlikely]] {
+            // Backpressure: the store can't keep up
+            _counters.stalls.fetch_add(1, std::memory_order_relaxed);
+            lock.unlock();
+            wake_flusher();
+            lock.lock();
+
+            if (shard.queue.size() >= _config.max_dirty) {
+                shard.drained.wait(lock);
+            }
+            it = shard.position.find(key);
+        }
+
+        // Under the shard lock: cache and dirty queue see the same order of updates per key
+        _cache.put(key, value);
+
+        if (it != shard.position.end()) {
+            shard.queue[it->second].second = std::forward<T>(value); // Coalesce
+            _counters.coalesced.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (shard.queue.empty()) shard.oldest = clock::now();
+
+        shard.position.emplace(key, shard.queue.size());
+        shard.queue.emplace_back(key, std::forward<T>(value));
+
+        if (shard.queue.size() == _config.max_batch) [[unlikely]] {
+            lock.unlock();
+            wake_flusher();
+        }
+    }
+
+    // Synchronous: everything put before the call is in the store after it
+    void flush() {
+        flush_pass(true);
+    }
+
+    Stats stats() const noexcept {
+        return {
+            _counters.puts.load(std::memory_order_relaxed),
+            _counters.coalesced.load(std::memory_order_relaxed),
+            _counters.flushed.load(std::memory_order_relaxed),
+            _counters.batches.load(std::memory_order_relaxed),
+            _counters.stalls.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+    Cache                               _cache;
+    Store&                              _store;
+    const Config                        _config;
+
+    std::array<DirtyShard, DirtyShards> _dirty;
+    Counters                            _counters;
+
+    std::mutex                          _flush_mtx;
+    std::vector<record>                 _scratch;       // owned by the flush pass
+
+    std::mutex                          _wake_mtx;
+    std::condition_variable             _wake_cv;
+    bool                                _wake = false;
+    bool                                _stop = false;
+    std::thread                         _flusher;
 };
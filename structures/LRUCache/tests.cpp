@@ -6,6 +6,11 @@
 #include <random>
 #include <array>
 #include <iomanip>
+#include <span>
+#include <ctime>
+#include <fstream>
+#include <cstdio>
+#include <limits>
 #include "LRUCache.cpp"
 //#include "Lv6_bdFlatLRU.cpp"
 
@@ -156,7 +161,13 @@ void run_benchmark(const TestConfig& config) {
               << "Ops/sec: "        << format_large_num(throughput) << "\n"
               << "Avg Latency: "    << avg_latency_ns << " ns\n"
               << "Misses: "         << format_large_num(total_misses.load())
-              << " (" << std::fixed << std::setprecision(2) << miss_rate << "%)\n\n";
+              << " (" << std::fixed << std::setprecision(2) << miss_rate << "%)\n";
+    if constexpr (requires { cache.trace_stats(); }) {
+        const auto trace = cache.trace_stats();
+        std::cout << "Trace records dropped: " << format_large_num(trace.dropped)
+                  << "   overwritten: " << format_large_num(trace.overwritten) << "\n";
+    }
+    std::cout << std::endl;
 }
 
 template<bool UseYield = false, typename... Caches>
@@ -182,6 +193,908 @@ std::cout << "========================================================\n"
     std::cout << "Done: " << (config.readers + config.writers) << " threads finished.\n" << std::endl;
 }
 
+// Fake slow backend: every write call costs one round-trip
+template <typename KeyType, typename ValueType>
+class InMemoryStore {
+public:
+    explicit InMemoryStore(std::chrono::microseconds latency) : _latency(latency) {}
+
+    void write_batch(std::span<const std::pair<KeyType, ValueType>> batch) {
+        std::this_thread::sleep_for(_latency);
+
+        std::lock_guard lock(_mtx);
+        for (const auto& [key, value] : batch) {
+            _data[key] = std::hash<ValueType>{}(value); // Payload itself is too heavy to keep
+        }
+        _records += batch.size();
+        _calls++;
+    }
+
+    uint64_t records() const noexcept { return _records; }
+    uint64_t calls() const noexcept { return _calls; }
+
+private:
+    std::chrono::microseconds                   _latency;
+    std::mutex                                  _mtx;
+    std::unordered_map<KeyType, std::size_t>    _data;
+    uint64_t                                    _records = 0;
+    uint64_t                                    _calls = 0;
+};
+
+template<typename Cache>
+void run_write_behind_benchmark(const TestConfig& config, std::chrono::microseconds store_latency) {
+    using Store = InMemoryStore<typename Cache::key_type, typename Cache::value_type>;
+    using WriteBehind = WriteBehindCache<Cache, Store>;
+
+    const auto& keys = BenchmarkData<key_amount>::get(config.key_range).keys;
+    const long long iterations = config.iterations / 100; // Synchronous pass is store-bound
+
+    auto run_writers = [&](auto&& put) {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (int i = 0; i < config.writers; ++i) {
+            threads.emplace_back([&, i]() {
+                typename Cache::value_type val{42};
+                std::size_t offset = (i * 100) & (config.key_amount - 1);
+
+                for (long long j = 0; j < iterations; ++j) {
+                    put(keys[(offset + j) & (config.key_amount - 1)], val);
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+        return diff.count();
+    };
+
+    auto report = [&](const char* mode, double seconds, const Store& store) {
+        double total_puts = (double)config.writers * iterations;
+        std::cout << mode << "\n"
+                  << "Avg put latency: "  << (seconds / iterations) * 1e9 << " ns\n"
+                  << "Store calls: "      << format_large_num(store.calls())
+                  << "   Store records: " << format_large_num(store.records())
+                  << " (" << std::fixed << std::setprecision(2) << (store.records() / total_puts) * 100.0 << "% of puts)\n";
+    };
+
+    std::cout << "Testing: " << WriteBehind::name() << " (store latency " << store_latency.count() << " us)..." << std::endl;
+
+    {
+        Store store(store_latency);
+        Cache cache;
+        double seconds = run_writers([&](int key, const auto& val) {
+            cache.put(key, val);
+            std::pair<int, typename Cache::value_type> record{key, val};
+            store.write_batch(std::span(&record, 1));
+        });
+        report("Write-through:", seconds, store);
+    }
+
+    {
+        Store store(store_latency);
+        double seconds = 0;
+        typename WriteBehind::Stats stats;
+        {
+            WriteBehind cache(store);
+            seconds = run_writers([&](int key, const auto& val) { cache.put(key, val); });
+            cache.flush();
+            stats = cache.stats();
+        }
+        report("Write-behind:", seconds, store);
+        std::cout << "Coalesced: " << format_large_num(stats.coalesced)
+                  << "   Batches: " << format_large_num(stats.batches)
+                  << "   Stalls: "  << format_large_num(stats.stalls) << "\n\n";
+    }
+}
+
+// Feed refresh: the whole key range twice, put() per item vs put_many() per batch
+template<typename Cache>
+void run_put_many_benchmark(const TestConfig& config, std::size_t batch_size) {
+    using Item = std::pair<typename Cache::key_type, typename Cache::value_type>;
+    std::vector<Item> batch;
+    batch.reserve(batch_size);
+
+    std::cout << "Testing: " << Cache::name() << " put_many (batch " << batch_size << ")..." << std::endl;
+
+    auto run = [&](auto&& ingest) {
+        Cache cache;
+        std::chrono::duration<double> spent{0};
+
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int first = 0; first <= config.key_range; first += batch_size) {
+                const int last = std::min<int>(first + batch_size, config.key_range + 1);
+                batch.clear();
+                for (int key = first; key < last; ++key) {
+                    batch.emplace_back(key, typename Cache::value_type(key + pass));
+                }
+
+                auto start = std::chrono::high_resolution_clock::now();
+                ingest(cache, std::span<const Item>(batch));
+                spent += std::chrono::high_resolution_clock::now() - start;
+            }
+        }
+        return spent.count();
+    };
+
+    double single = run([](Cache& cache, std::span<const Item> items) {
+        for (const auto& [key, value] : items) cache.put(key, value);
+    });
+    double batched = run([](Cache& cache, std::span<const Item> items) { cache.put_many(items); });
+
+    double total = 2.0 * (config.key_range + 1);
+    std::cout << "put():      " << format_large_num(total / single) << " ops/sec\n"
+              << "put_many(): " << format_large_num(total / batched) << " ops/sec ("
+              << std::fixed << std::setprecision(2) << single / batched << "x)\n\n";
+}
+
+// Oversubscribed writers on one lock: wall time, CPU burned and what the lock saw
+template<typename... Caches>
+void run_lock_benchmark(const TestConfig& config) {
+    const auto& keys = BenchmarkData<key_amount>::get(config.key_range).keys;
+    const int writers = 2 * std::max(1u, std::thread::hardware_concurrency());
+
+    auto run = [&]<typename Cache>() {
+        Cache cache;
+        std::atomic<bool> start_signal{false};
+        std::vector<std::thread> threads;
+
+        std::cout << "Testing: " << Cache::name() << " lock, " << writers << " writers..." << std::endl;
+
+        for (int i = 0; i < writers; ++i) {
+            threads.emplace_back([&, i]() {
+                typename Cache::value_type val{42};
+                std::size_t offset = (i * 100) & (config.key_amount - 1);
+
+                while(!start_signal.load(std::memory_order_acquire));
+
+                for (long long j = 0; j < config.iterations; ++j) {
+                    cache.put(keys[(offset + j) & (config.key_amount - 1)], val);
+                }
+            });
+        }
+
+        const std::clock_t cpu_start = std::clock();
+        auto start = std::chrono::high_resolution_clock::now();
+        start_signal.store(true, std::memory_order_release);
+        for (auto& t : threads) t.join();
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+        const double cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        std::cout << "Ops/sec: " << format_large_num(double(writers) * config.iterations / diff.count())
+                  << "   CPU/wall: " << std::fixed << std::setprecision(2) << cpu / diff.count() << "\n";
+        if constexpr (requires { cache.lock_stats(); }) {
+            const auto stats = cache.lock_stats();
+            std::cout << "Acquisitions: " << format_large_num(stats.acquisitions)
+                      << "   Spins/acq: " << std::fixed << std::setprecision(2) << double(stats.spins) / stats.acquisitions
+                      << "   Parks: " << format_large_num(stats.parks) << "\n";
+        }
+        std::cout << std::endl;
+    };
+
+    (run.template operator()<Caches>(), ...);
+}
+
+// Read-through: a miss pays the recompute cost, every 10th key is 100x more expensive
+template<typename... Caches>
+void run_cost_aware_benchmark(const TestConfig& config) {
+    std::vector<int> keys(config.key_amount);   // BenchmarkData keeps the range of its first user
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, config.key_range);
+    for (auto& k : keys) k = dist(gen);
+
+    auto cost_of = [](int key) { return key % 10 == 0 ? 200.0f : 2.0f; };
+
+    auto run = [&]<typename Cache>() {
+        Cache cache;
+        unsigned long long misses = 0;
+        double miss_cost = 0;
+
+        std::cout << "Testing: " << Cache::name() << " cost-aware..." << std::endl;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (long long j = 0; j < config.iterations; ++j) {
+            const int key = keys[j % keys.size()];
+            if (!cache.get(key)) {
+                misses++;
+                miss_cost += cost_of(key);
+                cache.put(key, typename Cache::value_type(key), cost_of(key));
+            }
+        }
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+
+        std::cout << "Ops/sec: " << format_large_num(config.iterations / diff.count())
+                  << "   Misses: " << std::fixed << std::setprecision(2) << 100.0 * misses / config.iterations << "%"
+                  << "   Recompute cost: " << format_large_num(miss_cost) << "\n\n";
+    };
+
+    (run.template operator()<Caches>(), ...);
+}
+
+// Read-through hit ratio by phase: a hot set under a loop 3x the cache (batch job), the loop alone, the hot set alone
+template<typename... Caches>
+void run_hit_ratio_benchmark(const TestConfig& config) {
+    const int hot_keys = config.cache_size / 2;
+    const int loop_keys = 3 * config.cache_size;
+
+    auto run = [&]<typename Cache>() {
+        Cache cache;
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<> hot(0, hot_keys - 1);
+        long long loop = 0;
+
+        std::cout << "Testing: " << Cache::name() << " hit ratio..." << std::endl;
+
+        auto phase = [&](const char* title, auto&& next_key) {
+            long long hits = 0;
+            for (long long j = 0; j < config.iterations; ++j) {
+                const int key = next_key();
+                if (cache.get(key)) {
+                    hits++;
+                } else {
+                    cache.put(key, typename Cache::value_type(key));
+                }
+            }
+            std::cout << title << std::fixed << std::setprecision(2) << 100.0 * hits / config.iterations << "%   ";
+        };
+
+        phase("Hot+Loop: ", [&] { return (gen() & 1) ? hot(gen) : hot_keys + int(loop++ % loop_keys); });
+        phase("Loop: ", [&] { return hot_keys + int(loop++ % loop_keys); });
+        phase("Hot: ", [&] { return hot(gen); });
+        std::cout << "\n\n";
+    };
+
+    (run.template operator()<Caches>(), ...);
+}
+
+// Skewed reads: 40% go to the thread's own 16 hot keys, the rest is spread over the key range
+template<typename... Caches>
+void run_near_cache_benchmark(const TestConfig& config) {
+    const auto& keys = BenchmarkData<key_amount>::get(config.key_range).keys;
+
+    auto run = [&]<typename Cache>() {
+        Cache cache;
+        std::atomic<bool> start_signal{false};
+        std::atomic<unsigned long long> checksum{0};
+        std::vector<std::thread> threads;
+
+        std::cout << "Testing: " << Cache::name() << " hot keys..." << std::endl;
+
+        typename Cache::value_type val{42};
+        for (int i = 0; i <= config.key_range; ++i) cache.put(i, val);
+
+        for (int i = 0; i < config.readers; ++i) {
+            threads.emplace_back([&, i]() {
+                unsigned long long local = 0;
+                std::size_t offset = (i * 100) & (config.key_amount - 1);
+                auto visit = [&local](const auto& value) { local += value.id; };
+
+                while(!start_signal.load(std::memory_order_acquire));
+
+                for (long long j = 0; j < config.iterations; ++j) {
+                    const int key = (j % 5 < 2) ? (i * 16 + int(j & 15)) % (config.key_range + 1)
+                                                : keys[(offset + j) & (config.key_amount - 1)];
+                    if constexpr (requires { cache.read(key, visit); }) {
+                        cache.read(key, visit);
+                    } else if (auto ptr = cache.get(key)) {
+                        visit(*ptr);
+                    }
+                }
+                checksum.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        start_signal.store(true, std::memory_order_release);
+        for (auto& t : threads) t.join();
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+
+        const double reads = (double)config.readers * config.iterations;
+        std::cout << "Ops/sec: " << format_large_num(reads / diff.count())
+                  << "   Avg Latency: " << std::fixed << std::setprecision(2) << diff.count() / reads * 1e9
+                  << " ns   (checksum " << checksum.load() << ")\n\n";
+    };
+
+    (run.template operator()<Caches>(), ...);
+}
+
+// Read-through with 20% of reads for keys the backend doesn't have: re-asked every time vs put_absent()
+template<typename Cache>
+void run_negative_cache_benchmark(const TestConfig& config) {
+    const int absent_keys = config.cache_size / 8;
+    std::vector<int> keys(config.key_amount);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> present(0, config.key_range);
+    std::uniform_int_distribution<> absent(1, absent_keys);
+    for (auto& k : keys) k = (gen() % 5 == 0) ? -absent(gen) : present(gen);   // Backend has no negative keys
+
+    auto run = [&](const char* mode, bool remember_absent) {
+        Cache cache;
+        unsigned long long backend_calls = 0;
+        unsigned long long known_absent = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (long long j = 0; j < config.iterations; ++j) {
+            const int key = keys[j % keys.size()];
+            auto res = cache.lookup(key);
+            if (res.presence == Presence::Absent) {
+                known_absent++;
+            } else if (res.presence == Presence::Miss) {
+                backend_calls++;
+                if (key >= 0) {
+                    cache.put(key, typename Cache::value_type(key));
+                } else if (remember_absent) {
+                    cache.put_absent(key);
+                }
+            }
+        }
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+
+        std::cout << mode << "\n"
+                  << "Ops/sec: " << format_large_num(config.iterations / diff.count())
+                  << "   Backend calls: " << format_large_num(backend_calls)
+                  << "   Known absent: " << std::fixed << std::setprecision(2) << 100.0 * known_absent / config.iterations << "%\n";
+    };
+
+    // get() hits with markers in the filter: it's probed only after a miss, hits must not slow down
+    // Expired markers are swept by the following puts
+    auto check_hit_path = [&]() {
+        auto cache = std::make_unique<Cache>();
+        const int hot = config.cache_size / 2;
+        for (int k = 0; k < hot; ++k) cache->put(k, typename Cache::value_type(k));
+
+        auto time_hits = [&]() {
+            unsigned long long found = 0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (long long j = 0; j < config.iterations; ++j) found += cache->get(keys[j % keys.size()] & (hot - 1)) != nullptr;
+            std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+            return std::pair{diff.count() / config.iterations * 1e9, found};
+        };
+
+        const auto [clean, clean_found] = time_hits();
+        for (int k = 1; k <= absent_keys; ++k) cache->put_absent(-k, std::chrono::milliseconds(1));
+        const std::size_t markers = cache->absent_size();
+        const auto [marked, marked_found] = time_hits();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        for (int k = 0; k < hot; ++k) cache->put(k, typename Cache::value_type(k + 1));
+
+        std::cout << "Hits, empty filter: " << clean << " ns   with " << markers << " markers: " << marked << " ns"
+                  << "   (found " << clean_found << " / " << marked_found << ")"
+                  << "\nMarkers left after expiry + " << hot << " puts: " << cache->absent_size() << "\n";
+    };
+
+    std::cout << "Testing: " << Cache::name() << " negative caching..." << std::endl;
+    run("Misses re-asked:", false);
+    run("Misses remembered:", true);
+    check_hit_path();
+    std::cout << "\n";
+}
+
+// 20-120 byte keys, looked up by string_view: no temporary std::string on the read path
+template<typename... Caches>
+void run_string_key_benchmark(const TestConfig& config) {
+    const auto& ids = BenchmarkData<key_amount>::get(config.key_range).keys;
+
+    std::vector<std::string> names(config.key_range + 1);
+    for (int i = 0; i <= config.key_range; ++i) {
+        names[i] = "tenant/" + std::to_string(i) + "/";
+        names[i].resize(20 + (i * 37) % 101, char('a' + i % 26));
+    }
+
+    auto run = [&]<typename Cache>() {
+        Cache cache;
+        std::atomic<unsigned long long> total_misses{0};
+        std::atomic<bool> start_signal{false};
+        std::vector<std::thread> threads;
+
+        std::cout << "Testing: " << Cache::name() << " <std::string>..." << std::endl;
+
+        typename Cache::value_type val{42};
+        for (const auto& name : names) cache.put(name, val);
+
+        for (int i = 0; i < config.readers + config.writers; ++i) {
+            threads.emplace_back([&, i]() {
+                const bool writer = i >= config.readers;
+                unsigned long long local_misses = 0;
+                std::size_t offset = (i * 100) & (config.key_amount - 1);
+
+                while(!start_signal.load(std::memory_order_acquire));
+
+                for (long long j = 0; j < config.iterations; ++j) {
+                    const std::string& name = names[ids[(offset + j) & (config.key_amount - 1)]];
+                    if (writer) {
+                        cache.put(name, val);
+                    } else if (!cache.get(std::string_view(name))) [[unlikely]] {
+                        local_misses++;
+                    }
+                }
+                total_misses.fetch_add(local_misses, std::memory_order_relaxed);
+            });
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        start_signal.store(true, std::memory_order_release);
+        for (auto& t : threads) t.join();
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+
+        double total_ops = (double)(config.readers + config.writers) * config.iterations;
+        std::cout << "Throughput: " << format_large_num(total_ops / diff.count()) << " ops/sec"
+                  << "   Miss Rate: " << std::fixed << std::setprecision(2)
+                  << (double)total_misses / ((double)config.readers * config.iterations) * 100.0 << "%\n\n";
+    };
+
+    (run.template operator()<Caches>(), ...);
+}
+
+// Save -> load round trip: values, LRU order (same survivors under the same eviction pressure), broken files refused
+template<typename Cache, typename OtherCache>
+void run_snapshot_test(const TestConfig& config, const std::string& path) {
+    using Record = snapshot::Record<typename Cache::key_type, typename Cache::value_type>;
+    const int stored = config.cache_size / 2;
+    const int hot = stored / 4;
+    auto value_of = [](int key) { return typename Cache::value_type(key) * 7 + 1; };
+
+    std::cout << "Testing: " << Cache::name() << " snapshot round trip..." << std::endl;
+
+    Cache original;
+    for (int k = 0; k < stored; ++k) original.put(k, value_of(k));
+    for (int k = 0; k < hot; ++k) original.put(k, value_of(k));     // Hot keys to the front
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const bool saved = original.save_snapshot(path);
+    std::chrono::duration<double> save_time = std::chrono::high_resolution_clock::now() - start;
+
+    Cache restored;
+    start = std::chrono::high_resolution_clock::now();
+    const std::size_t loaded = restored.load_snapshot(path);
+    std::chrono::duration<double> load_time = std::chrono::high_resolution_clock::now() - start;
+
+    int wrong_values = 0;
+    for (int k = 0; k < stored; ++k) {
+        auto ptr = restored.get(k);
+        if (!ptr || *ptr != value_of(k)) wrong_values++;
+    }
+
+    // Same fresh keys into both: the cold part of the old keys goes, identically if the order survived
+    for (int k = stored; k < stored + config.cache_size * 3 / 4; ++k) {
+        original.put(k, value_of(k));
+        restored.put(k, value_of(k));
+    }
+    int survivors = 0, hot_survivors = 0, different = 0;
+    for (int k = 0; k < stored; ++k) {
+        const bool in_original = original.lookup(k).presence == Presence::Hit;
+        const bool in_restored = restored.lookup(k).presence == Presence::Hit;
+        different += in_original != in_restored;
+        survivors += in_restored;
+        hot_survivors += in_restored && k < hot;
+    }
+
+    // Broken files: another value type, a wrapping section size, a truncated tail
+    OtherCache other;
+    const std::size_t other_loaded = other.load_snapshot(path);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto load_broken = [&](std::size_t size) {
+        {
+            std::ofstream out(path + ".broken", std::ios::binary);
+            out.write(bytes.data(), size);
+        }
+        Cache cache;
+        const std::size_t n = cache.load_snapshot(path + ".broken");
+        std::remove((path + ".broken").c_str());
+        return n;
+    };
+
+    snapshot::ShardIndex section;
+    const std::size_t section_at = sizeof(snapshot::Header);
+    std::memcpy(&section, bytes.data() + section_at, sizeof(section));
+    section.count = std::numeric_limits<uint64_t>::max() / sizeof(Record) + 1;    // count * sizeof(Record) wraps
+    std::memcpy(bytes.data() + section_at, &section, sizeof(section));
+    const std::size_t wrapped_loaded = load_broken(bytes.size());
+
+    std::memcpy(&section, bytes.data() + section_at, sizeof(section));
+    section.count = 1;
+    std::memcpy(bytes.data() + section_at, &section, sizeof(section));
+    const std::size_t truncated_loaded = load_broken(bytes.size() / 2);
+    std::remove(path.c_str());
+
+    const bool ok = saved && loaded == std::size_t(stored) && wrong_values == 0 && different == 0 && hot_survivors == hot
+                 && other_loaded == 0 && wrapped_loaded == 0 && truncated_loaded == 0;
+    std::cout << "Save: " << save_time.count() * 1e3 << " ms   Load: " << load_time.count() * 1e3 << " ms   Restored: " << loaded
+              << "\nAfter eviction: " << survivors << " / " << stored << " survived (hot " << hot_survivors << " / " << hot
+              << "), " << different << " differ from the original"
+              << "\nRejected: other value type " << (other_loaded == 0 ? "yes" : "NO")
+              << ", wrapping section " << (wrapped_loaded == 0 ? "yes" : "NO")
+              << ", truncated file " << (truncated_loaded == 0 ? "yes" : "NO")
+              << (ok ? "" : "\nSNAPSHOT TEST FAILED") << "\n\n";
+}
+
+// Lockless enumeration under churn: keys nobody writes are visited exactly once by for_each and parallel_for_each,
+// once the writers stop both see the same entries
+template<typename Cache>
+void run_scan_test(const TestConfig& config) {
+    const int stable = config.cache_size / 4;
+    const int churn = config.cache_size / 8;    // [stable, stable + churn): put & erased by the writers, no evictions
+    auto value_of = [](int key) { return typename Cache::value_type(key) * 7 + 1; };
+
+    std::cout << "Testing: " << Cache::name() << " for_each / parallel_for_each under writes..." << std::endl;
+
+    Cache cache;
+    for (int k = 0; k < stable + churn; ++k) cache.put(k, value_of(k));
+
+    std::vector<std::atomic<int>> visits(stable + churn);
+    std::atomic<int> wrong_values{0};
+    auto visitor = [&](const int& key, const auto& ptr) {
+        if (*ptr != value_of(key)) wrong_values.fetch_add(1, std::memory_order_relaxed);
+        visits[key].fetch_add(1, std::memory_order_relaxed);
+    };
+    // Stable keys visited exactly once, the rest at most once per pass (an erase-put moves a key to another slot)
+    auto stable_exact = [&]() {
+        int bad = 0;
+        for (int k = 0; k < stable; ++k) bad += visits[k].exchange(0, std::memory_order_relaxed) != 1;
+        for (int k = stable; k < stable + churn; ++k) visits[k].store(0, std::memory_order_relaxed);
+        return bad;
+    };
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < config.writers; ++w) {
+        writers.emplace_back([&, w]() {
+            std::mt19937 gen(w);
+            while (!stop.load(std::memory_order_relaxed)) {
+                const int key = stable + int(gen() % churn);
+                if (gen() & 1) cache.put(key, value_of(key));
+                else (void)cache.erase(key);
+            }
+        });
+    }
+
+    const int passes = 20;
+    int bad_serial = 0, bad_parallel = 0;
+    double serial_time = 0, parallel_time = 0;
+    for (int i = 0; i < passes; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        cache.for_each(visitor);
+        serial_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        bad_serial += stable_exact();
+
+        start = std::chrono::high_resolution_clock::now();
+        cache.parallel_for_each(visitor, 4, 256);
+        parallel_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        bad_parallel += stable_exact();
+    }
+
+    // More threads than the 32 epoch slots at once: each one leases its own or takes the locked path
+    const int crowd = 40;
+    std::atomic<int> missing_gets{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < crowd; ++r) {
+        readers.emplace_back([&, r]() {
+            for (int k = r; k < stable; k += crowd) {
+                auto ptr = cache.get(k);
+                if (!ptr) missing_gets.fetch_add(1, std::memory_order_relaxed);
+                else if (*ptr != value_of(k)) wrong_values.fetch_add(1, std::memory_order_relaxed);
+            }
+            cache.for_each([&](const int& key, const auto& ptr) {
+                if (*ptr != value_of(key)) wrong_values.fetch_add(1, std::memory_order_relaxed);
+            });
+        });
+    }
+    for (auto& t : readers) t.join();
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& t : writers) t.join();
+
+    // Quiet cache: the same entries both ways
+    const std::size_t serial_count = cache.for_each(visitor);
+    std::vector<int> serial_visits(visits.size());
+    for (std::size_t k = 0; k < visits.size(); ++k) serial_visits[k] = visits[k].exchange(0);
+    const std::size_t parallel_count = cache.parallel_for_each(visitor, 4, 256);
+    int mismatched = 0;
+    for (std::size_t k = 0; k < visits.size(); ++k) mismatched += visits[k].load() != serial_visits[k] || serial_visits[k] > 1;
+
+    const bool ok = bad_serial == 0 && bad_parallel == 0 && wrong_values == 0 && missing_gets == 0 && mismatched == 0 &&
+                    serial_count == parallel_count;
+    std::cout << "Serial pass: " << serial_time / passes * 1e3 << " ms   Parallel pass (4 threads): " << parallel_time / passes * 1e3 << " ms"
+              << "\nStable keys not visited exactly once: serial " << bad_serial << ", parallel " << bad_parallel
+              << "\n" << crowd << " threads at once: " << missing_gets << " stable keys missed, " << wrong_values << " wrong values"
+              << "\nQuiet: serial " << serial_count << " vs parallel " << parallel_count << " entries, " << mismatched << " keys differ"
+              << (ok ? "" : "\nSCAN TEST FAILED") << "\n\n";
+}
+
+// erase / erase_if under concurrent puts / O(1) clear followed by refills that go through sweep and slot reuse
+template<typename Cache, std::size_t Capacity>
+void run_erase_clear_test(const TestConfig& config) {
+    const int prefilled = Capacity / 2;
+    const int fresh = Capacity / 4;     // Put by the writers while erase_if runs, no evictions overall
+    auto value_of = [](int key) { return typename Cache::value_type(key) * 7 + 1; };
+    auto hit = [](Cache& cache, int key) {
+        if constexpr (requires { cache.lookup(key); }) return cache.lookup(key).presence == Presence::Hit;
+        else return cache.get(key).has_value();
+    };
+
+    std::cout << "Testing: " << Cache::name() << " erase / erase_if / clear..." << std::endl;
+    Cache cache;
+    for (int k = 0; k < prefilled; ++k) cache.put(k, value_of(k));
+
+    // erase: the key misses, a second erase finds nothing
+    int erase_errors = 0;
+    for (int k = 0; k < prefilled; k += 97) {
+        erase_errors += !cache.erase(k) || cache.erase(k) || hit(cache, k);
+        cache.put(k, value_of(k));
+    }
+
+    // erase_if: exactly the multiples of 3 below `prefilled`, while writers add keys above it
+    std::atomic<bool> start{false};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < config.writers; ++w) {
+        writers.emplace_back([&, w]() {
+            while (!start.load(std::memory_order_acquire));
+            for (int k = prefilled + w; k < prefilled + fresh; k += config.writers) cache.put(k, value_of(k));
+        });
+    }
+    start.store(true, std::memory_order_release);
+    const std::size_t erased = cache.erase_if([prefilled](const int& key, const auto&) {
+        return key < prefilled && key % 3 == 0;
+    });
+    for (auto& t : writers) t.join();
+
+    int erase_if_errors = 0;
+    for (int k = 0; k < prefilled + fresh; ++k) {
+        const bool expected = k >= prefilled || k % 3 != 0;
+        erase_if_errors += hit(cache, k) != expected;
+    }
+    const std::size_t expected_erased = (prefilled + 2) / 3;
+
+    // clear: old keys are gone at once, the full capacity is usable again and size() counts only the new era
+    const int rounds = 4;
+    int clear_errors = 0, size_errors = 0;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        const int base = (round + 1) * int(Capacity) * 2;
+        cache.clear();
+        if (cache.size() != 0) size_errors++;
+        for (int k = 0; k < prefilled + fresh; k += 7) clear_errors += hit(cache, k);
+        if (round > 0) for (int k = base - 2 * int(Capacity); k < base - int(Capacity); k += 7) clear_errors += hit(cache, k);
+
+        for (int k = base; k < base + int(Capacity); ++k) cache.put(k, value_of(k));
+        if (cache.size() != Capacity) size_errors++;
+        for (int k = base; k < base + int(Capacity); ++k) clear_errors += !hit(cache, k);
+    }
+    std::chrono::duration<double> clear_time = std::chrono::high_resolution_clock::now() - start_time;
+
+    const bool ok = erase_errors == 0 && erased == expected_erased && erase_if_errors == 0 && clear_errors == 0 && size_errors == 0;
+    std::cout << "erase: " << erase_errors << " errors   erase_if: " << erased << " / " << expected_erased << " erased, "
+              << erase_if_errors << " keys wrong"
+              << "\nclear + refill to capacity x" << rounds << ": " << clear_errors << " keys wrong, " << size_errors << " size mismatches, "
+              << clear_time.count() * 1e3 << " ms"
+              << (ok ? "" : "\nERASE / CLEAR TEST FAILED") << "\n\n";
+}
+
+// Counts live copies: values still pinned by the cache show up as alive
+struct TrackedValue {
+    static inline std::atomic<int> alive{0};
+    int v;
+    TrackedValue() noexcept : v(0) { alive++; }        // Flat maps construct a value in every slot
+    TrackedValue(int v) noexcept : v(v) { alive++; }
+    TrackedValue(const TrackedValue& other) noexcept : v(other.v) { alive++; }
+    TrackedValue& operator=(const TrackedValue&) = default;
+    ~TrackedValue() { alive--; }
+    bool operator==(const TrackedValue& other) const { return v == other.v; }
+};
+
+// Era-based clear() of the inline-value caches: nothing is freed by clear() itself,
+// later puts reclaim every stale slot through the amortized sweep
+template<typename Cache, std::size_t Capacity>
+void run_lazy_sweep_test() {
+    const int refill = Capacity / 2;    // SweepBudget * refill puts walk the whole table
+    std::cout << "Testing: " << Cache::name() << " lazy sweep after clear..." << std::endl;
+    auto cache = std::make_unique<Cache>();
+    const int alive_before = TrackedValue::alive;   // Counted from here: empty slots hold a value too
+
+    for (int k = 0; k < int(Capacity); ++k) cache->put(k, TrackedValue(k));
+    const int filled = TrackedValue::alive - alive_before;
+    const std::size_t size_filled = cache->size();
+
+    cache->clear();
+    const int after_clear = TrackedValue::alive - alive_before;
+    const std::size_t size_cleared = cache->size();
+    int wrong = 0;
+    for (int k = 0; k < int(Capacity); k += 7) wrong += cache->get(k).has_value();
+
+    const int base = 2 * Capacity;
+    for (int k = base; k < base + refill; ++k) cache->put(k, TrackedValue(k));
+    const int after_refill = TrackedValue::alive - alive_before;
+    const std::size_t size_refilled = cache->size();
+    for (int k = 0; k < int(Capacity); k += 7) wrong += cache->get(k).has_value();
+    for (int k = base; k < base + refill; ++k) {
+        const auto value = cache->get(k);
+        wrong += !value || value->v != k;
+    }
+
+    const bool ok = filled == int(Capacity) && size_filled == Capacity && after_clear == int(Capacity) && size_cleared == 0 &&
+                    after_refill == refill && size_refilled == std::size_t(refill) && wrong == 0;
+    std::cout << "Alive values: filled " << filled << ", after clear " << after_clear << " (size " << size_cleared
+              << "), after " << refill << " puts " << after_refill << " (size " << size_refilled << ")"
+              << "\nKeys wrong: " << wrong
+              << (ok ? "" : "\nLAZY SWEEP TEST FAILED") << "\n\n";
+}
+
+// Evicted / Erased / Cleared events with their counts, delivery after unlock, values freed by clear() itself
+template<std::size_t Capacity>
+void run_removal_listener_test() {
+    using Cache = Lv5_bdFlatLRU<int, TrackedValue, Capacity>;
+    const int erased_keys = Capacity / 8;
+
+    std::cout << "Testing: " << Cache::name() << " removal listener..." << std::endl;
+    auto cache = std::make_unique<Cache>();
+
+    std::array<std::size_t, 4> by_reason{};
+    std::size_t wrong_keys = 0;
+    std::size_t size_seen = 0;
+    cache->set_removal_listener({[&](auto events) {
+        for (const auto& e : events) {
+            by_reason[std::size_t(e.reason)]++;
+            wrong_keys += e.value->v != e.key;
+        }
+        size_seen = cache->size();  // Takes the lock: would self-deadlock if delivered under it
+    }, {}, 16});
+
+    // Evicted: the first `Capacity` keys, nothing touched them since
+    for (int k = 0; k < 2 * int(Capacity); ++k) cache->put(k, TrackedValue(k));
+    // Erased
+    for (int k = Capacity; k < int(Capacity) + erased_keys; ++k) cache->erase(k);
+    cache->flush_removals();
+    const std::size_t evicted = by_reason[std::size_t(RemovalReason::Evicted)];
+    const std::size_t erased = by_reason[std::size_t(RemovalReason::Erased)];
+
+    // Cleared: reported before clear() returns, no put needed
+    cache->clear();
+    const std::size_t cleared = by_reason[std::size_t(RemovalReason::Cleared)];
+    const int alive_after_clear = TrackedValue::alive.load();
+    const std::size_t lost = cache->lost_removals();
+
+    const bool ok = evicted == Capacity && erased == std::size_t(erased_keys) && cleared == Capacity - erased_keys &&
+                    wrong_keys == 0 && size_seen == 0 && alive_after_clear == 0 && lost == 0;
+    std::cout << "Evicted: " << evicted << " / " << Capacity << "   Erased: " << erased << " / " << erased_keys
+              << "   Cleared: " << cleared << " / " << Capacity - erased_keys << "   Wrong keys: " << wrong_keys << "   Lost: " << lost
+              << "\nValues alive after clear(): " << alive_after_clear << "   size() from the listener: " << size_seen
+              << (ok ? "" : "\nREMOVAL LISTENER TEST FAILED") << "\n\n";
+}
+
+// Contention swing quiet -> hot -> quiet: shards go deferred under load, back to strict after quiet windows
+// and stay put while the load is steady (hysteresis, no flapping)
+// Decisions are taken every 1024 writes per shard, so a phase is a number of writes, not a time span
+template<typename Cache>
+void run_adaptive_recency_test(const TestConfig& config) {
+    struct Phase {
+        const char* name;
+        int readers;
+        int writers;
+    };
+    const Phase phases[] = {
+        {"quiet", 0, 1}, {"hot", config.readers, config.writers}, {"hot, steady", config.readers, config.writers},
+        {"quiet", 0, 1}, {"quiet, steady", 0, 1}
+    };
+    const long long phase_writes = 8LL * 1024 * config.shards_amount;    // ~8 decision windows per shard
+
+    std::cout << "Testing: " << Cache::name() << " adaptive recency, " << config.shards_amount << " shards..." << std::endl;
+    auto cache = std::make_unique<Cache>();
+    for (int k = 0; k < config.cache_size; ++k) cache->put(k, uint64_t(k));
+
+    std::array<std::size_t, std::size(phases)> strict{};
+    std::array<uint64_t, std::size(phases)> switches{};
+    for (std::size_t p = 0; p < std::size(phases); ++p) {
+        const uint64_t before = cache->recency_switches();
+        std::atomic<int> writers_left{phases[p].writers};
+        std::atomic<std::size_t> sink{0};
+        std::vector<std::thread> threads;
+
+        for (int r = 0; r < phases[p].readers; ++r) {
+            threads.emplace_back([&, r]() {
+                std::mt19937 gen(r);
+                std::uniform_int_distribution<int> dist(0, config.key_range - 1);
+                std::size_t hits = 0;
+                while (writers_left.load(std::memory_order_relaxed) > 0) hits += cache->get(dist(gen)) != nullptr;
+                sink.fetch_add(hits, std::memory_order_relaxed);
+            });
+        }
+        for (int w = 0; w < phases[p].writers; ++w) {
+            threads.emplace_back([&, w]() {
+                std::mt19937 gen(1000 + w);
+                std::uniform_int_distribution<int> dist(0, config.key_range - 1);
+                for (long long i = 0; i < phase_writes / phases[p].writers; ++i) {
+                    const int key = dist(gen);
+                    cache->put(key, uint64_t(key) + p);    // New values: no quiet updates
+                }
+                writers_left.fetch_sub(1, std::memory_order_relaxed);
+            });
+        }
+        auto start_time = std::chrono::high_resolution_clock::now();
+        for (auto& t : threads) t.join();
+        std::chrono::duration<double> phase_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        strict[p] = cache->strict_shards();
+        switches[p] = cache->recency_switches() - before;
+        std::cout << std::left << std::setw(16) << phases[p].name << std::right
+                  << std::setw(2) << phases[p].readers << " readers, " << phases[p].writers << " writers   strict shards: "
+                  << strict[p] << " / " << config.shards_amount << "   switches: " << std::setw(2) << switches[p]
+                  << "   " << phase_time.count() * 1e3 << " ms\n";
+    }
+
+    // Steady phases: at most one switch per shard, a flapping shard switches on every window
+    const std::size_t shards = config.shards_amount;
+    const bool back_to_strict = strict[0] == shards && strict[4] == shards;
+    const bool went_deferred = strict[1] < shards || strict[2] < shards;
+    const bool no_flapping = switches[2] <= shards && switches[4] <= shards;
+    std::cout << (went_deferred ? "" : "No shard went deferred under load: too little contention on this machine\n")
+              << (back_to_strict && no_flapping ? "" : "ADAPTIVE RECENCY TEST FAILED\n") << "\n";
+}
+
+// Near cache with several instances in a thread: alternating between two costs no L1 flush,
+// get() / read() / put() from a read() visitor can't free the value it's looking at
+template<typename Cache>
+void run_near_reentrancy_test(const TestConfig& config) {
+    constexpr int instances = 6;        // More than a thread's L1s: nested calls take some over
+    constexpr int hot = 16;
+    std::vector<std::unique_ptr<Cache>> caches;
+    for (int c = 0; c < instances; ++c) {
+        caches.push_back(std::make_unique<Cache>());
+        for (int k = 0; k < config.cache_size / 2; ++k) caches.back()->put(k, TrackedValue(k));
+    }
+    Cache& a = *caches[0];
+    Cache& b = *caches[1];
+
+    std::cout << "Testing: " << Cache::name() << " near cache reentrancy / two instances..." << std::endl;
+
+    long long sum = 0;
+    auto time_gets = [&](auto&& get) {
+        for (int k = 0; k < hot; ++k) get(k), get(k);  // Past the doorkeeper
+        auto start = std::chrono::high_resolution_clock::now();
+        for (long long i = 0; i < config.iterations; ++i) get(int(i % hot));
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+        return diff.count() / config.iterations * 1e9;
+    };
+    const double one = time_gets([&](int k) { sum += a.get(k)->v; });
+    const double two = time_gets([&](int k) { sum += (k & 1 ? a : b).get(k)->v; });
+
+    // The visited value must survive its own erase (plus enough puts to free the retired values),
+    // churn on its L1 and takeovers by other instances
+    int wrong = 0;
+    for (int k = 0; k < hot; ++k) {
+        a.get(k), a.get(k);     // A near hit below
+        a.read(k, [&](const TrackedValue& value) {
+            a.erase(k);
+            for (int j = 0; j < 4 * hot; ++j) {
+                for (auto& cache : caches) cache->get(hot + j), cache->get(hot + j);
+                a.read(hot + j, [&](const TrackedValue& inner) { wrong += inner.v != hot + j; });
+                a.put(hot + j, TrackedValue(hot + j + 1)), a.put(hot + j, TrackedValue(hot + j));
+            }
+            wrong += value.v != k;
+        });
+        wrong += a.get(k) != nullptr;
+        a.put(k, TrackedValue(k));
+    }
+
+    std::cout << "get() on 1 instance: " << std::fixed << std::setprecision(2) << one << " ns   alternating 2 instances: " << two
+              << " ns   (checksum " << sum << ")\nValues wrong from nested calls: " << wrong
+              << (wrong == 0 ? "" : "\nNEAR REENTRANCY TEST FAILED") << "\n\n";
+}
+
+template <typename KeyType, typename ValueType, std::size_t Capacity>
+using Lv5_GDSF = Lv5_bdFlatLRU<KeyType, ValueType, Capacity, 32, HybridLock<>, EvictionPolicy::GDSF>;
+
+template <typename KeyType, typename ValueType, std::size_t Capacity>
+using Lv5_ARC = Lv5_bdFlatLRU<KeyType, ValueType, Capacity, 32, HybridLock<>, EvictionPolicy::ARC>;
+
+template <typename KeyType, typename ValueType, std::size_t Capacity>
+using Lv5_SLRU = Lv5_bdFlatLRU<KeyType, ValueType, Capacity, 32, HybridLock<>, EvictionPolicy::SLRU>;
+
 int main()
 {
     const long long iters = 1e6;
@@ -225,6 +1138,50 @@ int main()
 //    execute_scenario<false, Slow, Spin, Def, DefFM, Lv1_bdFM, Lv2_bdFM, Lv3_bdFM, Lv4_bdFM, Lv5_bdFM, S_Slow, S_Spin, S_Def, S_DefFM, S_Lv1_bdFM, S_Lv2_bdFM, S_Lv3_bdFM, S2_Lv4_bdFM, S3_Lv5_bdFM>(read_heavy);
 
     execute_scenario<false, /*S_Lv3_bdFM, */S2_Lv4_bdFM, S3_Lv5_bdFM>(read_heavy);
+
+    run_write_behind_benchmark<S3_Lv5_bdFM>(write_heavy, std::chrono::microseconds(20));
+    run_put_many_benchmark<S3_Lv5_bdFM>(write_heavy, 1024);
+
+    using S_Slow_Str = ShardedCache<StrictLRU, std::string, DataType, cache_sz, shards_amount>;
+    using S3_Lv5_bdFM_Str = Lv3_ShardedCache<Lv5_bdFlatLRU, std::string, DataType, cache_sz, shards_amount>;
+    run_string_key_benchmark<S_Slow_Str, S3_Lv5_bdFM_Str>(read_heavy);
+
+    using Spin_Mutex  = SpinlockedLRU<int, Payload<64>, cache_sz, std::mutex>;
+    using Spin_Hybrid = SpinlockedLRU<int, Payload<64>, cache_sz, HybridLock<>>;
+    using Spin_Fifo   = SpinlockedLRU<int, Payload<64>, cache_sz, HybridLock<true>>;
+    run_lock_benchmark<Spin_Mutex, Spin_Hybrid, Spin_Fifo>({0, 0, cache_sz, k_range, key_amount, iters / 10});
+
+    using S3_Lv5_LRU_Small  = Lv3_ShardedCache<Lv5_bdFlatLRU, int, Payload<64>, cache_sz, shards_amount>;
+    using S3_Lv5_GDSF_Small = Lv3_ShardedCache<Lv5_GDSF, int, Payload<64>, cache_sz, shards_amount>;
+    run_cost_aware_benchmark<S3_Lv5_LRU_Small, S3_Lv5_GDSF_Small>({1, 0, cache_sz, 4 * cache_sz, key_amount, 10 * iters});
+
+    using S3_Lv5_ARC_Small = Lv3_ShardedCache<Lv5_ARC, int, Payload<64>, cache_sz, shards_amount>;
+    using S3_Lv5_SLRU_Small = Lv3_ShardedCache<Lv5_SLRU, int, Payload<64>, cache_sz, shards_amount>;
+    run_hit_ratio_benchmark<S3_Lv5_LRU_Small, S3_Lv5_ARC_Small, S3_Lv5_SLRU_Small>({1, 0, cache_sz, k_range, key_amount, 4 * iters});
+
+    using S3_Lv5_Near16_Small = Lv3_ShardedCache<Lv5_bdFlatLRU, int, Payload<64>, cache_sz, shards_amount, 16>;
+    run_near_cache_benchmark<S3_Lv5_LRU_Small, S3_Lv5_Near16_Small>(read_heavy);
+
+    run_negative_cache_benchmark<S3_Lv5_LRU_Small>({1, 0, cache_sz, k_range, key_amount, 10 * iters});
+
+    using S3_Lv5_Snap = Lv3_ShardedCache<Lv5_bdFlatLRU, int, uint64_t, cache_sz, shards_amount>;
+    using S3_Lv5_Snap_Other = Lv3_ShardedCache<Lv5_bdFlatLRU, int, std::array<uint64_t, 2>, cache_sz, shards_amount>;
+    run_snapshot_test<S3_Lv5_Snap, S3_Lv5_Snap_Other>({1, 0, cache_sz, k_range, key_amount, iters}, "lru_snapshot.bin");
+    run_scan_test<S3_Lv5_Snap>({0, 2, cache_sz, k_range, key_amount, iters});
+    run_removal_listener_test<4 * 1024>();
+
+    using S3_Lv5_Near16_Tracked = Lv3_ShardedCache<Lv5_bdFlatLRU, int, TrackedValue, 4 * 1024, 4, 16>;
+    run_near_reentrancy_test<S3_Lv5_Near16_Tracked>({1, 0, 4 * 1024, 4 * 1024, key_amount, 10 * iters});
+    using S3_Lv5_Recency = Lv3_ShardedCache<Lv5_bdFlatLRU, int, uint64_t, cache_sz, 4>;
+    run_adaptive_recency_test<S3_Lv5_Recency>({16, 4, cache_sz, k_range, key_amount, iters, 128, 4});
+
+    // Small on purpose: int keys hash to themselves, dense ranges cluster and refills probe through the whole cluster
+    constexpr std::size_t erase_sz = 4 * 1024;
+    run_erase_clear_test<Lv3_bdFlatLRU<int, uint64_t, erase_sz>, erase_sz>({0, 2, erase_sz, k_range, key_amount, iters});
+    run_erase_clear_test<Lv4_bdFlatLRU<int, uint64_t, erase_sz>, erase_sz>({0, 2, erase_sz, k_range, key_amount, iters});
+    run_erase_clear_test<Lv5_bdFlatLRU<int, uint64_t, erase_sz>, erase_sz>({0, 2, erase_sz, k_range, key_amount, iters});
+    run_lazy_sweep_test<Lv3_bdFlatLRU<int, TrackedValue, erase_sz>, erase_sz>();
+    run_lazy_sweep_test<Lv4_bdFlatLRU<int, TrackedValue, erase_sz>, erase_sz>();
 //    execute_scenario<false, /*S_Lv3_bdFM, */S2_Lv4_bdFM, S3_Lv5_bdFM, S4_Lv6_bdFM>(read_heavy);
 /*
     execute_scenario<true, Slow, Spin, Def, DefFM, Lv1_bdFM, S_Slow, S_Spin, S_Def, S_DefFM, S_Lv1_bdFM>(balanced);
@@ -1,5 +1,29 @@
 #include <atomic>
 #include <vector>
+#include <span>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <memory>
+#include <bit>
+#include <new>
+#include <sys/mman.h>
+#include <cassert>
+#include <array>
+#include <limits>
+#include <initializer_list>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <sys/stat.h>
 
 class NonCopyableNonMoveable {
 public:
@@ -14,6 +38,91 @@ protected:
     ~NonCopyableNonMoveable() = default;
 };
 
+/*  Wait strategies for push_wait() / pop_wait(): one instance per direction (not full, not empty)
+*   wait(op) retries op until it succeeds, notify() runs after every successful opposite operation
+*   Only SpinParkWait has a non-empty notify(), the others cost nothing on the fast path
+*/
+struct BusySpinWait {
+    template <typename TryOp>
+    void wait(TryOp&& op) noexcept { while (!op()); }
+    void notify() noexcept {}
+};
+
+struct PauseSpinWait {
+    template <typename TryOp>
+    void wait(TryOp&& op) noexcept {
+        while (!op()) __builtin_ia32_pause();
+    }
+    void notify() noexcept {}
+};
+
+template <uint32_t Spins = 256>
+struct SpinYieldWait {
+    template <typename TryOp>
+    void wait(TryOp&& op) noexcept {
+        for (uint32_t i = 0; i < Spins; ++i) {
+            if (op()) return;
+            __builtin_ia32_pause();
+        }
+        while (!op()) std::this_thread::yield();
+    }
+    void notify() noexcept {}
+};
+
+/*  Spin, then sleep in atomic::wait on an epoch counter
+*   The notifier bumps the epoch & wakes only when a waiter is flagged; the seq_cst fences on both
+*   sides make sure a waiter either sees the data on its last try or the notifier sees the flag
+*/
+template <uint32_t Spins = 256>
+class SpinParkWait {
+public:
+    template <typename TryOp>
+    void wait(TryOp&& op) noexcept {
+        for (uint32_t i = 0; i < Spins; ++i) {
+            if (op()) return;
+            __builtin_ia32_pause();
+        }
+
+        while (true) {
+            _waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const uint32_t seen = _epoch.load(std::memory_order_acquire);
+
+            const bool done = op();
+            if (!done) _epoch.wait(seen, std::memory_order_acquire);
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (done || op()) return;
+        }
+    }
+
+    void notify() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+            _epoch.fetch_add(1, std::memory_order_release);
+            _epoch.notify_all();
+        }
+    }
+
+    // One item for one sleeper: the others stay parked instead of waking to find nothing
+    void notify_one() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+            _epoch.fetch_add(1, std::memory_order_release);
+            _epoch.notify_one();
+        }
+    }
+
+private:
+    std::atomic<uint32_t> _epoch{0};
+    std::atomic<uint32_t> _waiters{0};
+};
+
+// Member slot of a wait strategy: a stateful one gets its own cache line, notify() runs on every
+// push / pop and must not write next to the other side's indices; an empty one takes no space
+template <typename Wait, std::size_t CacheLine>
+struct alignas(std::is_empty_v<Wait> ? alignof(Wait) : CacheLine) WaitSlot : Wait {};
+
 /* It has:  False Sharing problem
 *           fixed size vector
 *           acq-rel fence
@@ -101,7 +210,7 @@ private:
 *           acq-rel fence
 *           division using bitwise "AND"
 */
-template <typename T, std::size_t Capacity>
+template <typename T, std::size_t Capacity, typename Wait = BusySpinWait>
 class SPSC_RingBufferUltraFast {
     
     static constexpr std::size_t CacheLine = 64; // Some hardcode :)
@@ -112,6 +221,15 @@ class SPSC_RingBufferUltraFast {
         else return (i + 1) % Capacity;
     }
 
+    std::size_t advance(std::size_t i, std::size_t n) const noexcept {
+        i += n;
+        return i >= Capacity ? i - Capacity : i;
+    }
+
+    std::size_t distance(std::size_t from, std::size_t to) const noexcept {
+        return to >= from ? to - from : Capacity - from + to;
+    }
+
 public:
     bool push(const T& value) {
         const std::size_t curr_t = tail.load(std::memory_order_relaxed);
@@ -123,6 +241,7 @@ public:
 
         buffer[curr_t] = value;
         tail.store(increment(curr_t), std::memory_order_release); // MB off
+        not_empty.notify();
 
         return true;
     }
@@ -137,10 +256,74 @@ public:
 
         value = buffer[curr_h];
         head.store(increment(curr_h), std::memory_order_release); // MB off
+        not_full.notify();
 
         return true;
     }
 
+    // Blocking: the Wait policy decides how the time is spent
+    void push_wait(const T& value) { not_full.wait([&] { return push(value); }); }
+    void pop_wait(T& value) { not_empty.wait([&] { return pop(value); }); }
+
+    /* Bulk: as many items as fit, one or two contiguous copies around the wrap
+    *  One release store per batch instead of per item
+    */
+    std::size_t push_n(std::span<const T> items) {
+        const std::size_t curr_t = tail.load(std::memory_order_relaxed);
+
+        std::size_t free = Capacity - 1 - distance(head_cache, curr_t);
+        if (free < items.size()) {
+            head_cache = head.load(std::memory_order_acquire); // MB on
+            free = Capacity - 1 - distance(head_cache, curr_t);
+        }
+
+        const std::size_t n = std::min(free, items.size());
+        const std::size_t first = std::min(n, Capacity - curr_t);
+        std::copy_n(items.begin(), first, buffer + curr_t);
+        std::copy_n(items.begin() + first, n - first, buffer);
+        tail.store(advance(curr_t, n), std::memory_order_release); // MB off
+        if (n) not_empty.notify();
+
+        return n;
+    }
+
+    std::size_t pop_n(std::span<T> out) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+
+        std::size_t ready = distance(curr_h, tail_cache);
+        if (ready < out.size()) {
+            tail_cache = tail.load(std::memory_order_acquire); // MB on
+            ready = distance(curr_h, tail_cache);
+        }
+
+        const std::size_t n = std::min(ready, out.size());
+        const std::size_t first = std::min(n, Capacity - curr_h);
+        std::copy_n(buffer + curr_h, first, out.begin());
+        std::copy_n(buffer, n - first, out.begin() + first);
+        head.store(advance(curr_h, n), std::memory_order_release); // MB off
+        if (n) not_full.notify();
+
+        return n;
+    }
+
+    // Everything published so far, read in place: the slots go back to the producer after the last call
+    template <typename F>
+    std::size_t consume_all(F&& func) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+        tail_cache = tail.load(std::memory_order_acquire); // MB on
+
+        const std::size_t n = distance(curr_h, tail_cache);
+        const std::size_t first = std::min(n, Capacity - curr_h);
+        for (std::size_t i = 0; i < first; ++i) func(std::as_const(buffer[curr_h + i]));
+        for (std::size_t i = 0; i < n - first; ++i) func(std::as_const(buffer[i]));
+        if (n) {
+            head.store(tail_cache, std::memory_order_release); // MB off
+            not_full.notify();
+        }
+
+        return n;
+    }
+
 private:
     T buffer[Capacity];
 
@@ -151,6 +334,300 @@ private:
     // Consumer's group
     alignas(CacheLine) std::atomic<std::size_t> head{0};
     std::size_t tail_cache{0}; // local
+
+    // Empty for the spinning strategies, a line each otherwise
+    [[no_unique_address]] WaitSlot<Wait, CacheLine> not_empty;  // Consumer waits, producer notifies
+    [[no_unique_address]] WaitSlot<Wait, CacheLine> not_full;   // Producer waits, consumer notifies
+};
+
+/*  Whole 2 MiB pages straight from mmap: explicit huge pages if reserved, otherwise THP via madvise
+*   For big long-lived buffers only, every allocation is at least one page
+*/
+template <typename T>
+struct MmapHugePageAllocator {
+    using value_type = T;
+    static constexpr std::size_t PageSize = 2 * 1024 * 1024;
+
+    MmapHugePageAllocator() noexcept = default;
+    template <typename U> MmapHugePageAllocator(const MmapHugePageAllocator<U>&) noexcept {}
+
+    static std::size_t bytes_for(std::size_t n) noexcept {
+        return (n * sizeof(T) + PageSize - 1) & ~(PageSize - 1);
+    }
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        const std::size_t bytes = bytes_for(n);
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED) {
+            ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) throw std::bad_alloc();
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        munmap(p, bytes_for(n));
+    }
+
+    friend bool operator==(const MmapHugePageAllocator&, const MmapHugePageAllocator&) = default;
+};
+
+/* UltraFast with the capacity picked at runtime: the buffer lives on the heap, not in the object
+*           capacity rounded up to a power of 2, "AND" masking
+*           cached indices, producer & consumer groups on separate cache lines
+*           read-only buffer pointer & mask on their own line
+*           storage from Alloc (huge pages by default)
+*/
+template <typename T, typename Alloc = MmapHugePageAllocator<T>, typename Wait = BusySpinWait>
+class SPSC_RingBufferDynamic : private NonCopyableNonMoveable {
+    static constexpr std::size_t CacheLine = 64; // Some hardcode :)
+
+public:
+    explicit SPSC_RingBufferDynamic(std::size_t capacity, const Alloc& alloc = Alloc{})
+        : allocator(alloc),
+          mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+          buffer(std::allocator_traits<Alloc>::allocate(allocator, mask + 1)) {
+        std::uninitialized_value_construct_n(buffer, mask + 1);
+    }
+
+    ~SPSC_RingBufferDynamic() {
+        std::destroy_n(buffer, mask + 1);
+        std::allocator_traits<Alloc>::deallocate(allocator, buffer, mask + 1);
+    }
+
+    // One slot always stays empty
+    std::size_t capacity() const noexcept { return mask; }
+
+    bool push(const T& value) {
+        const std::size_t curr_t = tail.load(std::memory_order_relaxed);
+        const std::size_t next = (curr_t + 1) & mask;
+
+        if (next == head_cache) {
+            head_cache = head.load(std::memory_order_acquire); // MB on
+            if (next == head_cache) return false;
+        }
+
+        buffer[curr_t] = value;
+        tail.store(next, std::memory_order_release); // MB off
+        not_empty.notify();
+
+        return true;
+    }
+
+    bool pop(T& value) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+
+        if (curr_h == tail_cache) {
+            tail_cache = tail.load(std::memory_order_acquire); // MB on
+            if (curr_h == tail_cache) return false;
+        }
+
+        value = buffer[curr_h];
+        head.store((curr_h + 1) & mask, std::memory_order_release); // MB off
+        not_full.notify();
+
+        return true;
+    }
+
+    void push_wait(const T& value) { not_full.wait([&] { return push(value); }); }
+    void pop_wait(T& value) { not_empty.wait([&] { return pop(value); }); }
+
+    std::size_t push_n(std::span<const T> items) {
+        const std::size_t curr_t = tail.load(std::memory_order_relaxed);
+
+        std::size_t free = (head_cache - curr_t - 1) & mask;
+        if (free < items.size()) {
+            head_cache = head.load(std::memory_order_acquire); // MB on
+            free = (head_cache - curr_t - 1) & mask;
+        }
+
+        const std::size_t n = std::min(free, items.size());
+        const std::size_t first = std::min(n, mask + 1 - curr_t);
+        std::copy_n(items.begin(), first, buffer + curr_t);
+        std::copy_n(items.begin() + first, n - first, buffer);
+        tail.store((curr_t + n) & mask, std::memory_order_release); // MB off
+        if (n) not_empty.notify();
+
+        return n;
+    }
+
+    std::size_t pop_n(std::span<T> out) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+
+        std::size_t ready = (tail_cache - curr_h) & mask;
+        if (ready < out.size()) {
+            tail_cache = tail.load(std::memory_order_acquire); // MB on
+            ready = (tail_cache - curr_h) & mask;
+        }
+
+        const std::size_t n = std::min(ready, out.size());
+        const std::size_t first = std::min(n, mask + 1 - curr_h);
+        std::copy_n(buffer + curr_h, first, out.begin());
+        std::copy_n(buffer, n - first, out.begin() + first);
+        head.store((curr_h + n) & mask, std::memory_order_release); // MB off
+        if (n) not_full.notify();
+
+        return n;
+    }
+
+    template <typename F>
+    std::size_t consume_all(F&& func) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+        tail_cache = tail.load(std::memory_order_acquire); // MB on
+
+        const std::size_t n = (tail_cache - curr_h) & mask;
+        const std::size_t first = std::min(n, mask + 1 - curr_h);
+        for (std::size_t i = 0; i < first; ++i) func(std::as_const(buffer[curr_h + i]));
+        for (std::size_t i = 0; i < n - first; ++i) func(std::as_const(buffer[i]));
+        if (n) {
+            head.store(tail_cache, std::memory_order_release); // MB off
+            not_full.notify();
+        }
+
+        return n;
+    }
+
+private:
+    // Shared, read-only after construction
+    [[no_unique_address]] Alloc allocator;
+    alignas(CacheLine) const std::size_t mask;
+    T* const buffer;
+
+    // Producer's group
+    alignas(CacheLine) std::atomic<std::size_t> tail{0};
+    std::size_t head_cache{0}; // local
+
+    // Consumer's group
+    alignas(CacheLine) std::atomic<std::size_t> head{0};
+    std::size_t tail_cache{0}; // local
+
+    [[no_unique_address]] WaitSlot<Wait, CacheLine> not_empty;
+    [[no_unique_address]] WaitSlot<Wait, CacheLine> not_full;
+};
+
+/*  Variable-length records, zero copy on both sides
+*   Producer: reserve(n) -> write the span in place -> commit()
+*   Consumer: peek() -> read the span in place -> release()
+*   Every record is an 8-byte header + payload, rounded up to 8 bytes; a record never wraps:
+*   when it doesn't fit before the end, a padding record fills the tail of the buffer
+*   Free-running 64-bit positions, "AND" masking, cached indices
+*/
+template <typename Alloc = MmapHugePageAllocator<std::byte>>
+class SPSC_ByteRing : private NonCopyableNonMoveable {
+    static constexpr std::size_t CacheLine = 64; // Some hardcode :)
+    static constexpr std::size_t Align = 8;
+
+    struct RecordHeader {
+        uint32_t length;    // Payload bytes
+        uint32_t padding;   // 1: skip to the start of the buffer
+    };
+    static_assert(sizeof(RecordHeader) == Align);
+
+    static constexpr std::size_t footprint(std::size_t n) noexcept {
+        return (sizeof(RecordHeader) + n + Align - 1) & ~(Align - 1);
+    }
+
+    RecordHeader* header_at(std::size_t pos) const noexcept {
+        return reinterpret_cast<RecordHeader*>(buffer + (pos & mask));
+    }
+
+public:
+    explicit SPSC_ByteRing(std::size_t bytes, const Alloc& alloc = Alloc{})
+        : allocator(alloc),
+          mask(std::bit_ceil(std::max<std::size_t>(bytes, 4096)) - 1),
+          buffer(std::allocator_traits<Alloc>::allocate(allocator, mask + 1)) {}
+
+    ~SPSC_ByteRing() {
+        std::allocator_traits<Alloc>::deallocate(allocator, buffer, mask + 1);
+    }
+
+    std::size_t capacity() const noexcept { return mask + 1; }
+
+    // Anything up to this size gets in once the consumer catches up
+    std::size_t max_record() const noexcept { return capacity() / 2 - sizeof(RecordHeader); }
+
+    // Writable payload of n bytes, data() == nullptr when there is no room right now
+    std::span<std::byte> reserve(std::size_t n) {
+        assert(n <= max_record() && "SPSC_ByteRing: record can never fit");
+
+        const std::size_t pos = tail.load(std::memory_order_relaxed);
+        const std::size_t to_end = capacity() - (pos & mask);
+        const std::size_t skip = footprint(n) > to_end ? to_end : 0;
+        const std::size_t needed = skip + footprint(n);
+
+        if (capacity() - (pos - head_cache) < needed) {
+            head_cache = head.load(std::memory_order_acquire); // MB on
+            if (capacity() - (pos - head_cache) < needed) return {};
+        }
+
+        if (skip) *header_at(pos) = {static_cast<uint32_t>(skip - sizeof(RecordHeader)), 1};
+        reserved_pos = pos + skip;
+        reserved_len = n;
+        return {buffer + (reserved_pos & mask) + sizeof(RecordHeader), n};
+    }
+
+    // Publishes the last reservation, `used` may be smaller than what was reserved
+    void commit(std::size_t used) {
+        assert(used <= reserved_len);
+        *header_at(reserved_pos) = {static_cast<uint32_t>(used), 0};
+        tail.store(reserved_pos + footprint(used), std::memory_order_release); // MB off
+    }
+
+    void commit() { commit(reserved_len); }
+
+    // Copying convenience on top of reserve/commit
+    bool push(std::span<const std::byte> record) {
+        auto dst = reserve(record.size());
+        if (!dst.data()) return false;
+        std::copy(record.begin(), record.end(), dst.begin());
+        commit();
+        return true;
+    }
+
+    // Oldest record in place, data() == nullptr when the ring is empty
+    std::span<const std::byte> peek() {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+
+        while (true) {
+            if (pos == tail_cache) {
+                tail_cache = tail.load(std::memory_order_acquire); // MB on
+                if (pos == tail_cache) return {};
+            }
+
+            const RecordHeader header = *header_at(pos);
+            if (!header.padding) {
+                peeked_len = footprint(header.length);
+                return {buffer + (pos & mask) + sizeof(RecordHeader), header.length};
+            }
+
+            pos += footprint(header.length);
+            head.store(pos, std::memory_order_release); // MB off, the padding is free space again
+        }
+    }
+
+    // Hands the peeked record's bytes back to the producer
+    void release() {
+        head.store(head.load(std::memory_order_relaxed) + peeked_len, std::memory_order_release); // MB off
+        peeked_len = 0;
+    }
+
+private:
+    // Shared, read-only after construction
+    [[no_unique_address]] Alloc allocator;
+    alignas(CacheLine) const std::size_t mask;
+    std::byte* const buffer;
+
+    // Producer's group
+    alignas(CacheLine) std::atomic<std::size_t> tail{0};
+    std::size_t head_cache{0}; // local
+    std::size_t reserved_pos{0};
+    std::size_t reserved_len{0};
+
+    // Consumer's group
+    alignas(CacheLine) std::atomic<std::size_t> head{0};
+    std::size_t tail_cache{0}; // local
+    std::size_t peeked_len{0};
 };
 
 /* It has:  False Sharing resolved with alignas
@@ -200,6 +677,53 @@ public:
         return true;
     }
 
+    // Bulk: free-running indices, so no wrap arithmetic except for the split copy
+    std::size_t push_n(std::span<const T> items) {
+        const std::size_t curr_t = tail.load(std::memory_order_relaxed);
+
+        if (Capacity - (curr_t - head_cache) < items.size()) {
+            head_cache = head.load(std::memory_order_acquire); // MB on
+        }
+
+        const std::size_t n = std::min(Capacity - (curr_t - head_cache), items.size());
+        const std::size_t pos = curr_t & Mask;
+        const std::size_t first = std::min(n, Capacity - pos);
+        std::copy_n(items.begin(), first, buffer + pos);
+        std::copy_n(items.begin() + first, n - first, buffer);
+        tail.fetch_add(n, std::memory_order_release); // MB off
+
+        return n;
+    }
+
+    std::size_t pop_n(std::span<T> out) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+
+        if (tail_cache - curr_h < out.size()) {
+            tail_cache = tail.load(std::memory_order_acquire); // MB on
+        }
+
+        const std::size_t n = std::min(tail_cache - curr_h, out.size());
+        const std::size_t pos = curr_h & Mask;
+        const std::size_t first = std::min(n, Capacity - pos);
+        std::copy_n(buffer + pos, first, out.begin());
+        std::copy_n(buffer, n - first, out.begin() + first);
+        head.fetch_add(n, std::memory_order_release); // MB off
+
+        return n;
+    }
+
+    template <typename F>
+    std::size_t consume_all(F&& func) {
+        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+        tail_cache = tail.load(std::memory_order_acquire); // MB on
+
+        const std::size_t n = tail_cache - curr_h;
+        for (std::size_t i = curr_h; i != tail_cache; ++i) func(std::as_const(buffer[i & Mask]));
+        if (n) head.fetch_add(n, std::memory_order_release); // MB off
+
+        return n;
+    }
+
 private:
 /*    static constexpr std::size_t get_index(size_t i) noexcept {
         return i & Mask;
@@ -216,69 +740,484 @@ private:
     std::size_t tail_cache{0};
 };
 
-/* It has:  False Sharing resolved with alignas
+/*  Disruptor-style broadcast: one producer, every consumer sees every item, nothing is copied per consumer
+*   Each consumer owns a sequence (items processed) on its own cache line and reads behind a barrier:
+*   the producer cursor, or the sequences of the consumers it depends on (dependency chains)
+*   The producer gates on the slowest consumer
+*   Consumers are added before the producer starts; ids are 0, 1, ... in the order of add_consumer()
+*/
+template <typename T, std::size_t Capacity, std::size_t MaxConsumers = 8>
+class SPMC_BroadcastRing : private NonCopyableNonMoveable {
+    static constexpr std::size_t CacheLine = 64; // Some hardcode :)
+    static constexpr bool isPowerOfTwo(std::size_t n) { return (n != 0) && (n & (n - 1)) == 0; }
+    static constexpr std::size_t Mask = Capacity - 1;
+    static_assert(isPowerOfTwo(Capacity), "Capacity must be power of 2");
+    static_assert(MaxConsumers > 0 && MaxConsumers <= 32, "Dependencies are a 32-bit mask");
+
+    struct alignas(CacheLine) Consumer {
+        std::atomic<std::size_t>    sequence{0};    // Items processed
+        std::size_t                 barrier_cache{0}; // local
+        uint32_t                    depends_on{0};  // Bit per consumer, 0: reads behind the producer
+    };
+
+    std::size_t slowest_consumer() const noexcept {
+        std::size_t slowest = cursor.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < consumer_count; ++i) {
+            slowest = std::min(slowest, consumers[i].sequence.load(std::memory_order_acquire));
+        }
+        return slowest;
+    }
+
+    std::size_t barrier(const Consumer& consumer) const noexcept {
+        if (!consumer.depends_on) return cursor.load(std::memory_order_acquire);
+
+        std::size_t limit = std::numeric_limits<std::size_t>::max();
+        for (uint32_t deps = consumer.depends_on; deps; deps &= deps - 1) {
+            limit = std::min(limit, consumers[std::countr_zero(deps)].sequence.load(std::memory_order_acquire));
+        }
+        return limit;
+    }
+
+public:
+    using consumer_id = std::size_t;
+
+    // Not thread-safe: set the graph up before the producer & consumers start
+    consumer_id add_consumer(std::initializer_list<consumer_id> depends_on = {}) {
+        assert(consumer_count < MaxConsumers);
+        auto& consumer = consumers[consumer_count];
+        for (auto dep : depends_on) {
+            assert(dep < consumer_count && "A consumer depends only on ones added before it");
+            consumer.depends_on |= uint32_t(1) << dep;
+        }
+        consumer.sequence.store(cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return consumer_count++;
+    }
+
+    // Producer: a slot to fill in place, nullptr while the slowest consumer is a lap behind
+    T* try_claim() noexcept {
+        const std::size_t seq = cursor.load(std::memory_order_relaxed);
+        if (seq - gate_cache >= Capacity) {
+            gate_cache = slowest_consumer(); // MB on
+            if (seq - gate_cache >= Capacity) return nullptr;
+        }
+        return &buffer[seq & Mask];
+    }
+
+    void publish() noexcept {
+        cursor.store(cursor.load(std::memory_order_relaxed) + 1, std::memory_order_release); // MB off
+    }
+
+    bool push(const T& value) {
+        T* slot = try_claim();
+        if (!slot) return false;
+        *slot = value;
+        publish();
+        return true;
+    }
+
+    // Consumer: func(const T&) on everything its barrier lets through (up to max), then one release store
+    template <typename F>
+    std::size_t consume(consumer_id id, F&& func, std::size_t max = std::numeric_limits<std::size_t>::max()) {
+        auto& consumer = consumers[id];
+        const std::size_t seq = consumer.sequence.load(std::memory_order_relaxed);
+
+        if (seq == consumer.barrier_cache) {
+            consumer.barrier_cache = barrier(consumer); // MB on
+            if (seq == consumer.barrier_cache) return 0;
+        }
+
+        const std::size_t n = std::min(consumer.barrier_cache - seq, max);
+        for (std::size_t i = 0; i < n; ++i) func(std::as_const(buffer[(seq + i) & Mask]));
+        consumer.sequence.store(seq + n, std::memory_order_release); // MB off
+
+        return n;
+    }
+
+    std::size_t consumer_sequence(consumer_id id) const noexcept {
+        return consumers[id].sequence.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(CacheLine) T buffer[Capacity];
+
+    // Producer's group
+    alignas(CacheLine) std::atomic<std::size_t> cursor{0};  // Items published
+    std::size_t gate_cache{0}; // local
+    std::size_t consumer_count{0};
+
+    std::array<Consumer, MaxConsumers> consumers;
+};
+
+/*  SPSC ring in shared memory (memfd or POSIX shm) for two processes
+*   Layout: versioned header + T[Capacity], only indices & trivially copyable values in the mapping
+*   Roles: each side holds an OFD lock on its own byte of the file; the kernel drops it when the
+*   process dies, so peer_alive() can't be fooled by a reused pid
+*   Waits: spin, then a shared (not private) futex; the other side calls futex_wake only when a waiter is flagged
+*/
+enum class RingRole : uint8_t { Producer, Consumer };
+enum class RingStatus : uint8_t { Ok, Timeout, PeerGone };
+
+template <typename T, std::size_t Capacity>
+class SPSC_SharedRing : private NonCopyableNonMoveable {
+    static constexpr std::size_t CacheLine = 64; // Some hardcode :)
+    static constexpr bool isPowerOfTwo(std::size_t n) { return (n != 0) && (n & (n - 1)) == 0; }
+    static constexpr std::size_t Mask = Capacity - 1;
+    static_assert(isPowerOfTwo(Capacity), "Capacity must be power of 2");
+    static_assert(std::is_trivially_copyable_v<T>, "Values are shared as raw bytes");
+
+    static constexpr uint64_t Magic = 0x474E495243505353ULL;   // "SSPCRING"
+    static constexpr uint32_t Version = 1;
+    static constexpr uint32_t SpinLimit = 1024;
+    static constexpr auto PeerCheck = std::chrono::milliseconds(10); // Futex sleep between liveness checks
+
+    struct alignas(CacheLine) Header {
+        // Written once by the creator, checked by attach()
+        uint64_t                magic;
+        uint32_t                version;
+        uint32_t                value_size;
+        uint64_t                capacity;
+        std::atomic<uint32_t>   ready;              // Last thing the creator writes
+
+        // Producer's group
+        alignas(CacheLine) std::atomic<uint64_t> tail;
+        std::atomic<uint32_t>   space_seq;          // Futex word the producer sleeps on
+        std::atomic<uint32_t>   producer_waiting;
+        std::atomic<int32_t>    producer_pid;       // Diagnostics only
+
+        // Consumer's group
+        alignas(CacheLine) std::atomic<uint64_t> head;
+        std::atomic<uint32_t>   data_seq;           // Futex word the consumer sleeps on
+        std::atomic<uint32_t>   consumer_waiting;
+        std::atomic<int32_t>    consumer_pid;
+    };
+
+    static constexpr std::size_t MappingSize = sizeof(Header) + Capacity * sizeof(T);
+
+    static void futex_wait(std::atomic<uint32_t>& word, uint32_t seen, std::chrono::nanoseconds timeout) noexcept {
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        timespec ts{static_cast<time_t>(secs.count()), static_cast<long>((timeout - secs).count())};
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, seen, &ts, nullptr, 0);
+    }
+
+    static void futex_wake(std::atomic<uint32_t>& word) noexcept {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+    }
+
+    static void notify(std::atomic<uint32_t>& word, const std::atomic<uint32_t>& waiting) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+            word.fetch_add(1, std::memory_order_release);
+            futex_wake(word);
+        }
+    }
+
+    static int lock_byte(RingRole role) noexcept { return role == RingRole::Producer ? 0 : 1; }
+
+    static flock role_lock(RingRole role, short type) noexcept {
+        flock fl{};
+        fl.l_type = type;
+        fl.l_whence = SEEK_SET;
+        fl.l_start = lock_byte(role);
+        fl.l_len = 1;
+        return fl;
+    }
+
+    [[noreturn]] static void fail(const char* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Released by the members themselves: a constructor that throws half way leaks neither
+    struct Descriptor {
+        int value = -1;
+        ~Descriptor() { if (value >= 0) close(value); }     // Drops the role lock
+    };
+
+    struct Mapping {
+        void* ptr = nullptr;
+        ~Mapping() { if (ptr) munmap(ptr, MappingSize); }
+    };
+
+    SPSC_SharedRing(int fd, RingRole role, bool create) : _role(role) {
+        // Own open file description: a descriptor inherited through fork() would share the role locks
+        char path[64];
+        std::snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+        _fd.value = open(path, O_RDWR | O_CLOEXEC);
+        if (_fd.value < 0) fail("SPSC_SharedRing: reopen");
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        if (create) {
+            if (ftruncate(_fd.value, MappingSize) != 0) fail("SPSC_SharedRing: ftruncate");
+        } else {
+            struct stat st{};   // Touching the mapping past the end of the file is SIGBUS
+            while (fstat(_fd.value, &st) == 0 && static_cast<std::size_t>(st.st_size) < MappingSize) {
+                if (std::chrono::steady_clock::now() > deadline) throw std::runtime_error("SPSC_SharedRing: file too small");
+                std::this_thread::yield();
+            }
+        }
+
+        void* ptr = mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd.value, 0);
+        if (ptr == MAP_FAILED) fail("SPSC_SharedRing: mmap");
+        _mapping.ptr = ptr;
+        _header = static_cast<Header*>(ptr);
+        _buffer = reinterpret_cast<T*>(static_cast<char*>(ptr) + sizeof(Header));
+
+        if (create) {
+            _header->magic = Magic;
+            _header->version = Version;
+            _header->value_size = sizeof(T);
+            _header->capacity = Capacity;
+            _header->ready.store(1, std::memory_order_release);
+        } else {
+            while (_header->ready.load(std::memory_order_acquire) != 1) {
+                if (std::chrono::steady_clock::now() > deadline) throw std::runtime_error("SPSC_SharedRing: header never became ready");
+                std::this_thread::yield();
+            }
+            if (_header->magic != Magic || _header->version != Version ||
+                _header->value_size != sizeof(T) || _header->capacity != Capacity) {
+                throw std::runtime_error("SPSC_SharedRing: layout mismatch");
+            }
+        }
+
+        auto fl = role_lock(role, F_WRLCK);
+        if (fcntl(_fd.value, F_OFD_SETLK, &fl) != 0) {
+            throw std::runtime_error(role == RingRole::Producer ? "SPSC_SharedRing: producer already attached"
+                                                                : "SPSC_SharedRing: consumer already attached");
+        }
+        (role == RingRole::Producer ? _header->producer_pid : _header->consumer_pid).store(getpid(), std::memory_order_relaxed);
+
+        _head_cache = _header->head.load(std::memory_order_acquire);
+        _tail_cache = _header->tail.load(std::memory_order_acquire);
+    }
+
+public:
+    // Anonymous memory: hand fd() to the peer through fork() or SCM_RIGHTS
+    static std::unique_ptr<SPSC_SharedRing> create_memfd(const char* name, RingRole role) {
+        const Descriptor fd{memfd_create(name, MFD_CLOEXEC)};
+        if (fd.value < 0) fail("SPSC_SharedRing: memfd_create");
+        return std::unique_ptr<SPSC_SharedRing>(new SPSC_SharedRing(fd.value, role, true));
+    }
+
+    // Named: "/name", the creator owns the name until unlink()
+    static std::unique_ptr<SPSC_SharedRing> open_shm(const char* name, RingRole role, bool create) {
+        const Descriptor fd{shm_open(name, O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0600)};
+        if (fd.value < 0) fail("SPSC_SharedRing: shm_open");
+        return std::unique_ptr<SPSC_SharedRing>(new SPSC_SharedRing(fd.value, role, create));
+    }
+
+    // After fork() the child holds a copy of the parent's ring (mapping & descriptor): destroy it
+    // once attached, the copy keeps the parent's role lock, and so peer_alive(), alive
+    static std::unique_ptr<SPSC_SharedRing> attach(int fd, RingRole role) {
+        return std::unique_ptr<SPSC_SharedRing>(new SPSC_SharedRing(fd, role, false));
+    }
+
+    static void unlink(const char* name) noexcept { shm_unlink(name); }
+
+    int fd() const noexcept { return _fd.value; }
+
+    // The peer holds its role lock, i.e. it attached and its process is still running
+    bool peer_alive() const noexcept {
+        auto fl = role_lock(_role == RingRole::Producer ? RingRole::Consumer : RingRole::Producer, F_WRLCK);
+        if (fcntl(_fd.value, F_OFD_GETLK, &fl) != 0) return false;
+        return fl.l_type != F_UNLCK;
+    }
+
+    bool push(const T& value) noexcept {
+        assert(_role == RingRole::Producer);
+        const uint64_t curr_t = _header->tail.load(std::memory_order_relaxed);
+
+        if (curr_t - _head_cache >= Capacity) {
+            _head_cache = _header->head.load(std::memory_order_acquire); // MB on
+            if (curr_t - _head_cache >= Capacity) return false;
+        }
+
+        _buffer[curr_t & Mask] = value;
+        _header->tail.store(curr_t + 1, std::memory_order_release); // MB off
+        notify(_header->data_seq, _header->consumer_waiting);
+
+        return true;
+    }
+
+    bool pop(T& value) noexcept {
+        assert(_role == RingRole::Consumer);
+        const uint64_t curr_h = _header->head.load(std::memory_order_relaxed);
+
+        if (curr_h == _tail_cache) {
+            _tail_cache = _header->tail.load(std::memory_order_acquire); // MB on
+            if (curr_h == _tail_cache) return false;
+        }
+
+        value = _buffer[curr_h & Mask];
+        _header->head.store(curr_h + 1, std::memory_order_release); // MB off
+        notify(_header->space_seq, _header->producer_waiting);
+
+        return true;
+    }
+
+    RingStatus push_wait(const T& value, std::chrono::nanoseconds timeout) {
+        return wait([&] { return push(value); }, _header->space_seq, _header->producer_waiting, timeout);
+    }
+
+    RingStatus pop_wait(T& value, std::chrono::nanoseconds timeout) {
+        return wait([&] { return pop(value); }, _header->data_seq, _header->consumer_waiting, timeout);
+    }
+
+private:
+    template <typename TryOp>
+    RingStatus wait(TryOp&& op, std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiting, std::chrono::nanoseconds timeout) {
+        for (uint32_t i = 0; i < SpinLimit; ++i) {
+            if (op()) return RingStatus::Ok;
+            __builtin_ia32_pause();
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            waiting.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const uint32_t seen = word.load(std::memory_order_acquire);
+
+            const bool done = op();
+            if (!done) futex_wait(word, seen, std::min<std::chrono::nanoseconds>(PeerCheck, timeout));
+            waiting.fetch_sub(1, std::memory_order_relaxed);
+
+            if (done || op()) return RingStatus::Ok;
+            if (!peer_alive()) return op() ? RingStatus::Ok : RingStatus::PeerGone; // Drain what a dead producer left
+            if (std::chrono::steady_clock::now() >= deadline) return RingStatus::Timeout;
+        }
+    }
+
+    Descriptor      _fd;                // Closed after the mapping is gone
+    Mapping         _mapping;
+    Header*         _header = nullptr;
+    T*              _buffer = nullptr;
+    RingRole        _role;
+
+    // Local to this process
+    uint64_t        _head_cache = 0;
+    uint64_t        _tail_cache = 0;
+};
+
+/* Bounded MPMC queue (Vyukov): every cell has a sequence number, so a slot is published
+*           only after its value is written, and producers share nothing but the enqueue index
+*           False Sharing resolved with alignas
 *           array
-*           acq-rel fence
+*           acq-rel on the cell sequence, relaxed CAS on the indices
 *           division using bitwise "AND"
 */
-template <typename T, std::size_t Capacity>
-class MPSC_TraceBuffer : private NonCopyableNonMoveable{    // Use EBO
+template <typename ValueType, std::size_t Capacity, typename Wait = BusySpinWait>
+class MPMC_BoundedQueue : private NonCopyableNonMoveable{    // Use EBO
 public:
-    static constexpr const char* name() noexcept { return "MPSC_TraceBuffer"; }
+    static constexpr const char* name() noexcept { return "MPMC_BoundedQueue"; }
+    using value_type = ValueType;
 
 private:
     static constexpr std::size_t CacheLine = 64; // Some hardcode :)
     static constexpr bool isPowerOfTwo(std::size_t n) { return (n != 0) && (n & (n - 1)) == 0; }
     static constexpr std::size_t Mask = Capacity - 1;
-    static_assert(isPowerOfTwo(Capacity), "Capacity must be power of 2");
+    static_assert(isPowerOfTwo(Capacity) && Capacity >= 2, "Capacity must be power of 2");
+
+    struct Cell {
+        std::atomic<std::size_t>    seq;    // pos: free for the push at pos, pos + 1: filled by it
+        ValueType                   value;
+    };
+
+    static std::ptrdiff_t lag(std::size_t seq, std::size_t pos) noexcept {
+        return static_cast<std::ptrdiff_t>(seq - pos);
+    }
 
 public:
+    MPMC_BoundedQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) buffer[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Approximate: the indices are read at different moments
+    std::size_t size() const noexcept {
+        const std::size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+        const std::size_t head = dequeue_pos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
     bool isItTime() const noexcept {
-        return (tail - head > (Capacity / 2));
+        return size() > Capacity / 2;
     }
 
-    bool push(const T& value) {
-        std::size_t curr_t = tail.load(std::memory_order_relaxed);
-        while (true) { // CAS
-            if (((curr_t + 1) & Mask) == head_cache) {
-                head_cache = head.load(std::memory_order_acquire);
-                if (((curr_t + 1) & Mask) == head_cache) {
-                    return false;
-                }
-            }
+    bool push(const ValueType& value) {
+        std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &buffer[pos & Mask];
+            const std::ptrdiff_t diff = lag(cell->seq.load(std::memory_order_acquire), pos); // MB on
 
-            // Write
-            if (tail.compare_exchange_weak(curr_t, (curr_t + 1) & Mask,
-                                         std::memory_order_release,         // MB off
-                                         std::memory_order_relaxed)) {
-                buffer[curr_t] = value;
-                return true;
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Full: the cell still holds the value from a lap ago
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
             }
         }
+
+        cell->value = value;
+        cell->seq.store(pos + 1, std::memory_order_release); // MB off
+        not_empty.notify();
+        return true;
     }
 
-    bool pop(T& value) {
-        const std::size_t curr_h = head.load(std::memory_order_relaxed);
+    bool pop(ValueType& value) {
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &buffer[pos & Mask];
+            const std::ptrdiff_t diff = lag(cell->seq.load(std::memory_order_acquire), pos + 1); // MB on
 
-        if (curr_h == tail_cache) {
-            tail_cache = tail.load(std::memory_order_acquire); // MB on
-            if (curr_h == tail_cache) return false;
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Empty, or the producer of this cell hasn't finished yet
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
         }
 
-        value = buffer[curr_h];
-        head.store((curr_h + 1) & Mask, std::memory_order_release); // MB off
-
+        value = std::move(cell->value);
+        cell->seq.store(pos + Capacity, std::memory_order_release); // MB off
+        not_full.notify();
         return true;
     }
 
+    void push_wait(const ValueType& value) { not_full.wait([&] { return push(value); }); }
+    void pop_wait(ValueType& value) { not_empty.wait([&] { return pop(value); }); }
+
+    // Batch: claims the run of filled cells at the head with one CAS
+    std::size_t pop_n(std::span<ValueType> out) {
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        std::size_t n = 0;
+        while (true) {
+            n = 0;
+            while (n < out.size() && lag(buffer[(pos + n) & Mask].seq.load(std::memory_order_acquire), pos + n + 1) == 0) {
+                ++n;
+            }
+            if (n == 0) return 0;
+            if (dequeue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) break;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            Cell& cell = buffer[(pos + i) & Mask];
+            out[i] = std::move(cell.value);
+            cell.seq.store(pos + i + Capacity, std::memory_order_release); // MB off
+        }
+        not_full.notify();
+        return n;
+    }
+
 private:
-    T buffer[Capacity];
+    alignas(CacheLine) Cell buffer[Capacity];
 
-    // Producer's group
-    alignas(CacheLine) std::atomic<std::size_t> tail{0};
-    std::size_t head_cache{0}; // local
+    // Producers' group
+    alignas(CacheLine) std::atomic<std::size_t> enqueue_pos{0};
 
-    // Consumer's group
-    alignas(CacheLine) std::atomic<std::size_t> head{0};
-    std::size_t tail_cache{0}; // local
+    // Consumers' group
+    alignas(CacheLine) std::atomic<std::size_t> dequeue_pos{0};
+
+    [[no_unique_address]] WaitSlot<Wait, CacheLine> not_empty;
+    [[no_unique_address]] WaitSlot<Wait, CacheLine> not_full;
 };
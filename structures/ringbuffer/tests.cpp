@@ -1,6 +1,18 @@
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <vector>
+#include <ctime>
+#include <cstring>
+#include <array>
+#include <sys/wait.h>
+#include <fstream>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <pthread.h>
+#include <x86intrin.h>
 #include "ringbuffer.cpp"
 
 template<typename Buffer>
@@ -30,8 +42,469 @@ void run_test(Buffer& pool, long long iterations) {
     std::cout << "Time: " << diff.count() << " s \nOps/sec: " << (iterations / diff.count()) / 1e6 << " M\n";
 }
 
-int main()
+// Batches of `batch` items: push_n/pop_n copy runs, consume_all reads in place
+template<typename Buffer>
+void run_batch_test(Buffer& pool, long long iterations, std::size_t batch, bool in_place) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread producer([&]() {
+        std::vector<long long> items(batch);
+        for (long long i = 0; i < iterations; i += batch) {
+            const std::size_t n = std::min<long long>(batch, iterations - i);
+            for (std::size_t k = 0; k < n; ++k) items[k] = i + k;
+
+            std::size_t done = 0;
+            while (done < n) {
+                done += pool.push_n(std::span<const long long>(items.data() + done, n - done));
+            }
+        }
+    });
+
+    long long sum = 0;
+    std::thread consumer([&]() {
+        std::vector<long long> items(batch);
+        long long received = 0;
+        while (received < iterations) {
+            if (in_place) {
+                received += pool.consume_all([&sum](const long long& val) { sum += val; });
+            } else {
+                const std::size_t n = pool.pop_n(std::span<long long>(items));
+                for (std::size_t k = 0; k < n; ++k) sum += items[k];
+                received += n;
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff = end - start;
+    const bool ok = sum == iterations * (iterations - 1) / 2;
+    std::cout << "Time: " << diff.count() << " s \nOps/sec: " << (iterations / diff.count()) / 1e6 << " M"
+              << (ok ? "" : "   CHECKSUM MISMATCH") << "\n";
+}
+
+// Producers push disjoint ranges; batch > 1 makes the consumers drain with pop_n
+template<typename Queue>
+void run_mpmc_test(Queue& pool, long long iterations, int producers, int consumers, std::size_t batch) {
+    std::atomic<long long> received{0};
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> threads;
+    const long long per_producer = iterations / producers;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (long long i = p * per_producer; i < (p + 1) * per_producer; ++i) {
+                while (!pool.push(i))
+                ;
+            }
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            std::vector<long long> items(batch);
+            long long local = 0;
+            while (received.load(std::memory_order_relaxed) < per_producer * producers) {
+                std::size_t n = 0;
+                if (batch > 1) {
+                    n = pool.pop_n(std::span<long long>(items));
+                } else if (pool.pop(items[0])) {
+                    n = 1;
+                }
+                for (std::size_t k = 0; k < n; ++k) local += items[k];
+                if (n) received.fetch_add(n, std::memory_order_relaxed);
+            }
+            sum.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    for (auto& t : threads) t.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff = end - start;
+    const long long total = per_producer * producers;
+    const bool ok = sum.load() == total * (total - 1) / 2;
+    std::cout << "Time: " << diff.count() << " s \nOps/sec: " << (total / diff.count()) / 1e6 << " M"
+              << (ok ? "" : "   CHECKSUM MISMATCH") << "\n";
+}
+
+// Idle consumer: a message every `gap`, wake-up latency = pop_wait() return - push time, CPU = consumer thread time / wall
+template<typename Buffer>
+void run_wait_test(Buffer& pool, int messages, std::chrono::microseconds gap) {
+    using clock = std::chrono::steady_clock;
+    auto thread_cpu = [] {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+    };
+
+    double cpu = 0;
+    double total_latency = 0;
+    double max_latency = 0;
+    auto start = clock::now();
+
+    std::thread consumer([&]() {
+        const double cpu_start = thread_cpu();
+        long long sent;
+        for (int i = 0; i < messages; ++i) {
+            pool.pop_wait(sent);
+            const double latency = (clock::now().time_since_epoch().count() - sent) * 1e-3;
+            total_latency += latency;
+            max_latency = std::max(max_latency, latency);
+        }
+        cpu = thread_cpu() - cpu_start;
+    });
+
+    for (int i = 0; i < messages; ++i) {
+        std::this_thread::sleep_for(gap);
+        pool.push_wait(clock::now().time_since_epoch().count());
+    }
+    consumer.join();
+
+    std::chrono::duration<double> wall = clock::now() - start;
+    std::cout << "Wake-up latency avg: " << total_latency / messages << " us   max: " << max_latency
+              << " us \nConsumer CPU: " << 100.0 * cpu / wall.count() << " %\n";
+}
+
+// Records of 16 B - 4 KiB written and read in place, the first 8 bytes carry the sequence number
+template<typename Ring>
+void run_byte_ring_test(Ring& ring, long long messages) {
+    auto record_size = [](long long i) { return 16 + std::size_t(i * 2654435761u) % 4081; };
+    unsigned long long bytes = 0;
+    bool ok = true;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread producer([&]() {
+        for (long long i = 0; i < messages; ++i) {
+            std::span<std::byte> record;
+            while (!(record = ring.reserve(record_size(i))).data())
+            ;
+            std::memcpy(record.data(), &i, sizeof(i));
+            ring.commit();
+        }
+    });
+
+    std::thread consumer([&]() {
+        for (long long i = 0; i < messages; ++i) {
+            std::span<const std::byte> record;
+            while (!(record = ring.peek()).data())
+            ;
+            long long seq;
+            std::memcpy(&seq, record.data(), sizeof(seq));
+            ok &= seq == i && record.size() == record_size(i);
+            bytes += record.size();
+            ring.release();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff = end - start;
+    std::cout << "Time: " << diff.count() << " s \nOps/sec: " << (messages / diff.count()) / 1e6 << " M   "
+              << bytes / diff.count() / (1024 * 1024) << " MiB/s" << (ok ? "" : "   SEQUENCE MISMATCH") << "\n";
+}
+
+// Fan-out: metrics & logging read behind the producer, invalidation reads behind metrics
+template<typename Ring>
+void run_broadcast_test(Ring& ring, long long iterations) {
+    const auto metrics = ring.add_consumer();
+    const auto invalidation = ring.add_consumer({metrics});
+    const auto logging = ring.add_consumer();
+
+    std::array<long long, 3> sums{};
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (auto id : {metrics, invalidation, logging}) {
+        threads.emplace_back([&, id]() {
+            long long sum = 0;
+            long long received = 0;
+            while (received < iterations) {
+                received += ring.consume(id, [&sum](const long long& val) { sum += val; });
+            }
+            sums[id] = sum;
+        });
+    }
+
+    for (long long i = 0; i < iterations; ++i) {
+        long long* slot;
+        while (!(slot = ring.try_claim()))
+        ;
+        *slot = i;
+        ring.publish();
+    }
+    for (auto& t : threads) t.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff = end - start;
+    const long long expected = iterations * (iterations - 1) / 2;
+    const bool ok = sums[0] == expected && sums[1] == expected && sums[2] == expected;
+    std::cout << "Time: " << diff.count() << " s \nOps/sec: " << (iterations / diff.count()) / 1e6 << " M (x3 readers)"
+              << (ok ? "" : "   CHECKSUM MISMATCH") << "\n";
+}
+
+// Producer in this process, consumer in a forked one; the consumer reports one-way latency (CLOCK_MONOTONIC is shared)
+template<typename Ring>
+void run_shared_ring_test(long long messages, std::chrono::microseconds gap) {
+    using clock = std::chrono::steady_clock;
+    auto producer = Ring::create_memfd("ringbuffer-test", RingRole::Producer);
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        auto consumer = Ring::attach(producer->fd(), RingRole::Consumer);
+        producer.reset();
+
+        std::array<long long, 2> msg;
+        double total_latency = 0;
+        for (long long i = 0; i < messages; ++i) {
+            if (consumer->pop_wait(msg, std::chrono::seconds(5)) != RingStatus::Ok || msg[0] != i) {
+                std::cout << "Consumer: lost the producer at " << i << std::endl;
+                _exit(1);
+            }
+            total_latency += (clock::now().time_since_epoch().count() - msg[1]) * 1e-3;
+        }
+        std::cout << "Avg latency: " << total_latency / messages << " us" << std::endl;
+        _exit(0);
+    }
+
+    while (!producer->peer_alive())
+    ;
+    auto start = clock::now();
+    for (long long i = 0; i < messages; ++i) {
+        if (gap.count()) std::this_thread::sleep_for(gap);
+        producer->push_wait({i, clock::now().time_since_epoch().count()}, std::chrono::seconds(5));
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    std::chrono::duration<double> diff = clock::now() - start;
+    std::cout << "Time: " << diff.count() << " s \nOps/sec: " << (messages / diff.count()) / 1e6 << " M"
+              << (WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "" : "   CONSUMER FAILED")
+              << "   Peer gone after exit: " << (producer->peer_alive() ? "no" : "yes") << "\n";
+}
+
+// Latency mode: rdtsc stamps, cores pinned. TSC is assumed invariant and synced across cores/sockets
+struct TscClock {
+    double ticks_per_ns;
+
+    static uint64_t now() noexcept { return __rdtsc(); }
+
+    static TscClock calibrate(std::chrono::milliseconds period = std::chrono::milliseconds(100)) {
+        using clock = std::chrono::steady_clock;
+        const auto t0 = clock::now();
+        const uint64_t c0 = now();
+        std::this_thread::sleep_for(period);
+        const uint64_t c1 = now();
+        const auto t1 = clock::now();
+        return {double(c1 - c0) / std::chrono::duration<double, std::nano>(t1 - t0).count()};
+    }
+
+    double to_ns(uint64_t ticks) const noexcept { return ticks / ticks_per_ns; }
+};
+
+// Log-linear: 2^SubBits linear buckets per power of two, ~3% relative error, fixed 15 KiB
+class LatencyHistogram {
+    static constexpr int SubBits = 5;
+    static constexpr uint64_t Sub = uint64_t(1) << SubBits;
+
+    static std::size_t index(uint64_t v) noexcept {
+        if (v < Sub) return v;
+        const int e = 63 - __builtin_clzll(v);
+        return (e - SubBits + 1) * Sub + ((v >> (e - SubBits)) & (Sub - 1));
+    }
+
+    // The highest value that falls into the bucket
+    static uint64_t upper(std::size_t i) noexcept {
+        if (i < Sub) return i;
+        const int e = i / Sub + SubBits - 1;
+        return ((uint64_t(1) << e) | ((i % Sub) << (e - SubBits))) + (uint64_t(1) << (e - SubBits)) - 1;
+    }
+
+public:
+    void record(uint64_t v) noexcept {
+        ++counts[index(v)];
+        ++total;
+        max = std::max(max, v);
+    }
+
+    uint64_t percentile(double p) const noexcept {
+        const uint64_t rank = std::max<uint64_t>(1, std::ceil(p / 100 * total));
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(upper(i), max);
+        }
+        return max;
+    }
+
+    uint64_t maximum() const noexcept { return max; }
+
+private:
+    std::array<uint64_t, (64 - SubBits + 1) * Sub> counts{};
+    uint64_t total{0};
+    uint64_t max{0};
+};
+
+inline int cpu_topology(int cpu, const char* what) {
+    std::ifstream in("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + what);
+    int value = -1;
+    in >> value;
+    return value;
+}
+
+inline bool pin_this_thread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// One-way latency: the producer stamps a message every `gap` and pushes it, the consumer subtracts on pop.
+// Ring-agnostic, push(long long) / pop(long long&) adapt the variant
+template<typename Push, typename Pop>
+void run_latency_test(const char* name, Push&& push, Pop&& pop, long long messages,
+                      int producer_cpu, int consumer_cpu, const TscClock& tsc,
+                      std::chrono::nanoseconds gap = std::chrono::microseconds(1)) {
+    LatencyHistogram histogram;
+    bool consumer_pinned = false, producer_pinned = false;     // One per thread, read after join()
+
+    std::thread consumer([&]() {
+        consumer_pinned = pin_this_thread(consumer_cpu);
+        long long sent;
+        for (long long i = 0; i < messages; ++i) {
+            while (!pop(sent))
+            ;
+            const long long ticks = TscClock::now() - sent;
+            histogram.record(ticks > 0 ? ticks : 0);
+        }
+    });
+
+    std::thread producer([&]() {
+        producer_pinned = pin_this_thread(producer_cpu);
+        const uint64_t gap_ticks = gap.count() * tsc.ticks_per_ns;
+        for (long long i = 0; i < messages; ++i) {
+            const uint64_t next = TscClock::now() + gap_ticks;
+            while (TscClock::now() < next) __builtin_ia32_pause();
+
+            const long long stamp = TscClock::now(); // Stamped once, time spent on a full ring counts too
+            while (!push(stamp))
+            ;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    const bool pinned = consumer_pinned && producer_pinned;
+
+    std::printf("%-26s p50: %8.0f ns  p99: %8.0f ns  p99.9: %8.0f ns  max: %10.0f ns%s\n", name,
+                tsc.to_ns(histogram.percentile(50)), tsc.to_ns(histogram.percentile(99)),
+                tsc.to_ns(histogram.percentile(99.9)), tsc.to_ns(histogram.maximum()),
+                pinned ? "" : "   (NOT PINNED)");
+}
+
+// Every variant, one producer -> one consumer, long long payload
+void run_latency_suite(int producer_cpu, int consumer_cpu, long long messages, const TscClock& tsc) {
+    constexpr std::size_t capacity = 4 * 1024;
+    auto run = [&](const char* name, auto&& push, auto&& pop) {
+        run_latency_test(name, push, pop, messages, producer_cpu, consumer_cpu, tsc);
+    };
+    auto run_ring = [&](const char* name, auto& ring) {
+        run(name, [&](long long v) { return ring.push(v); }, [&](long long& v) { return ring.pop(v); });
+    };
+
+    SPSC_RingBufferUltraFast<long long, capacity> ultrafast;
+    run_ring("UltraFastSPSC", ultrafast);
+    SPSC_RingBufferFast<long long, capacity> fast;
+    run_ring("FastSPSC", fast);
+    SPSC_RingBufferSlow<long long> slow(capacity);
+    run_ring("SlowSPSC", slow);
+    SPSC_RingBufferExperimental<long long, capacity> experimental;
+    run_ring("ExperimentalSPSC", experimental);
+    SPSC_RingBufferDynamic<long long> dynamic(capacity);
+    run_ring("DynamicSPSC", dynamic);
+    MPMC_BoundedQueue<long long, capacity> mpmc;
+    run_ring("MPMC_BoundedQueue", mpmc);
+
+    SPSC_ByteRing<> byte_ring(64 * 1024);
+    run("SPSC_ByteRing",
+        [&](long long v) { return byte_ring.push(std::as_bytes(std::span(&v, 1))); },
+        [&](long long& v) {
+            auto record = byte_ring.peek();
+            if (!record.data()) return false;
+            std::memcpy(&v, record.data(), sizeof(v));
+            byte_ring.release();
+            return true;
+        });
+
+    SPMC_BroadcastRing<long long, capacity> broadcast;
+    const auto id = broadcast.add_consumer();
+    run("SPMC_BroadcastRing",
+        [&](long long v) { return broadcast.push(v); },
+        [&](long long& v) { return broadcast.consume(id, [&](long long x) { v = x; }, 1) == 1; });
+
+    // Both ends in one process, the same mapping path as across processes
+    using SharedRing = SPSC_SharedRing<long long, capacity>;
+    auto shared_producer = SharedRing::create_memfd("ringbuffer-latency", RingRole::Producer);
+    auto shared_consumer = SharedRing::attach(shared_producer->fd(), RingRole::Consumer);
+    run("SPSC_SharedRing",
+        [&](long long v) { return shared_producer->push(v); },
+        [&](long long& v) { return shared_consumer->pop(v); });
+}
+
+// Same core, SMT sibling, same socket, cross socket, as far as the machine has them (producer on cpu 0)
+void run_latency_topologies(long long messages, const TscClock& tsc) {
+    const int cpus = std::thread::hardware_concurrency();
+    const int core = cpu_topology(0, "core_id");
+    const int socket = cpu_topology(0, "physical_package_id");
+
+    auto find = [&](auto&& match) {
+        for (int cpu = 1; cpu < cpus; ++cpu)
+            if (match(cpu_topology(cpu, "physical_package_id"), cpu_topology(cpu, "core_id"))) return cpu;
+        return -1;
+    };
+    const std::pair<const char*, int> layouts[] = {
+        {"same core", 0},
+        {"SMT sibling", find([&](int s, int c) { return s == socket && c == core; })},
+        {"same socket", find([&](int s, int c) { return s == socket && c != core; })},
+        {"cross socket", find([&](int s, int) { return s != socket; })},
+    };
+
+    for (auto [layout, cpu] : layouts) {
+        if (cpu < 0) {
+            std::cout << "\nLatency, " << layout << ": no such cpu here, skipped" << std::endl;
+            continue;
+        }
+        std::cout << "\nLatency, " << layout << " (cpu 0 -> cpu " << cpu << ")..." << std::endl;
+        run_latency_suite(0, cpu, messages, tsc);
+    }
+}
+
+// ./a.out                                       throughput
+// ./a.out latency [producer_cpu consumer_cpu]   latency histograms, every topology when no cpus are given
+int main(int argc, char** argv)
 {
+    if (argc > 1 && std::strcmp(argv[1], "latency") == 0) {
+        const long long messages = 1e6;
+        const auto tsc = TscClock::calibrate();
+        std::cout << "TSC: " << tsc.ticks_per_ns << " ticks/ns" << std::endl;
+
+        if (argc > 3) {
+            const int producer_cpu = std::atoi(argv[2]), consumer_cpu = std::atoi(argv[3]);
+            std::cout << "\nLatency, cpu " << producer_cpu << " -> cpu " << consumer_cpu << "..." << std::endl;
+            run_latency_suite(producer_cpu, consumer_cpu, messages, tsc);
+        } else {
+            run_latency_topologies(messages, tsc);
+        }
+        return 0;
+    }
+
     const long long iterations = 1e8;
     const std::size_t capacity = 4 * 1024;
 
@@ -51,10 +524,86 @@ int main()
     SPSC_RingBufferExperimental<long long, capacity> experimental;
     run_test(experimental, iterations);
 
+    std::cout << "\nTesting UltraFastSPSC RingBuffer, push_n/pop_n by 64..." << std::endl;
+    SPSC_RingBufferUltraFast<long long, capacity> ultrafast_bulk;
+    run_batch_test(ultrafast_bulk, iterations, 64, false);
+
+    std::cout << "\nTesting UltraFastSPSC RingBuffer, push_n by 64 / consume_all..." << std::endl;
+    SPSC_RingBufferUltraFast<long long, capacity> ultrafast_drain;
+    run_batch_test(ultrafast_drain, iterations, 64, true);
+
+    std::cout << "\nTesting DynamicSPSC RingBuffer (runtime capacity, huge pages)..." << std::endl;
+    SPSC_RingBufferDynamic<long long> dynamic(capacity);
+    run_test(dynamic, iterations);
+
+    // Bursty ingestion: 64 MiB of ring, the producer runs far ahead of the consumer
+    std::cout << "\nTesting DynamicSPSC RingBuffer, 8M entries, push_n/pop_n by 64..." << std::endl;
+    SPSC_RingBufferDynamic<long long> dynamic_big(8 * 1024 * 1024);
+    run_batch_test(dynamic_big, iterations, 64, false);
+
+    std::cout << "\nTesting SPSC_ByteRing, 16 B - 4 KiB records, 4 MiB ring..." << std::endl;
+    SPSC_ByteRing<> byte_ring(4 * 1024 * 1024);
+    run_byte_ring_test(byte_ring, iterations / 100);
+
+    std::cout << "\nTesting SPMC_BroadcastRing, 3 consumers (one behind another)..." << std::endl;
+    SPMC_BroadcastRing<long long, capacity> broadcast;
+    run_broadcast_test(broadcast, iterations / 10);
+
+    using SharedRing = SPSC_SharedRing<std::array<long long, 2>, capacity>;
+    std::cout << "\nTesting SPSC_SharedRing across processes, busy..." << std::endl;
+    run_shared_ring_test<SharedRing>(iterations / 10, std::chrono::microseconds(0));
+
+    std::cout << "\nTesting SPSC_SharedRing across processes, a message every 200 us (futex wake-ups)..." << std::endl;
+    run_shared_ring_test<SharedRing>(2000, std::chrono::microseconds(200));
+
+    std::cout << "\nTesting ExperimentalSPSC RingBuffer, push_n/pop_n by 64..." << std::endl;
+    SPSC_RingBufferExperimental<long long, capacity> experimental_bulk;
+    run_batch_test(experimental_bulk, iterations, 64, false);
+
+    std::cout << "\nTesting ExperimentalSPSC RingBuffer, push_n by 64 / consume_all..." << std::endl;
+    SPSC_RingBufferExperimental<long long, capacity> experimental_drain;
+    run_batch_test(experimental_drain, iterations, 64, true);
+
     // Unfair, but it is degenerate case. Overheads only, without profit
-    std::cout << "\nTesting MPSC_TraceBuffer RingBuffer..." << std::endl;
-    MPSC_TraceBuffer<long long, capacity> tracebuffer;
-    run_test(tracebuffer, iterations);
+    std::cout << "\nTesting MPMC_BoundedQueue, 1 producer / 1 consumer..." << std::endl;
+    MPMC_BoundedQueue<long long, capacity> mpmc;
+    run_test(mpmc, iterations);
+
+    std::cout << "\nTesting MPMC_BoundedQueue, 4 producers / 1 consumer, pop_n by 64..." << std::endl;
+    MPMC_BoundedQueue<long long, capacity> mpsc;
+    run_mpmc_test(mpsc, iterations, 4, 1, 64);
+
+    std::cout << "\nTesting MPMC_BoundedQueue, 4 producers / 4 consumers..." << std::endl;
+    MPMC_BoundedQueue<long long, capacity> mpmc4;
+    run_mpmc_test(mpmc4, iterations, 4, 4, 1);
+
+    const int messages = 2000;
+    const auto gap = std::chrono::microseconds(200);
+
+    std::cout << "\nTesting wait strategies, idle consumer..." << std::endl;
+    std::cout << "BusySpinWait" << std::endl;
+    SPSC_RingBufferUltraFast<long long, capacity, BusySpinWait> busy_spin;
+    run_wait_test(busy_spin, messages, gap);
+
+    std::cout << "PauseSpinWait" << std::endl;
+    SPSC_RingBufferUltraFast<long long, capacity, PauseSpinWait> pause_spin;
+    run_wait_test(pause_spin, messages, gap);
+
+    std::cout << "SpinYieldWait" << std::endl;
+    SPSC_RingBufferUltraFast<long long, capacity, SpinYieldWait<>> spin_yield;
+    run_wait_test(spin_yield, messages, gap);
+
+    std::cout << "SpinParkWait" << std::endl;
+    SPSC_RingBufferUltraFast<long long, capacity, SpinParkWait<>> spin_park;
+    run_wait_test(spin_park, messages, gap);
+
+    std::cout << "SpinParkWait, MPMC_BoundedQueue" << std::endl;
+    MPMC_BoundedQueue<long long, capacity, SpinParkWait<>> mpmc_park;
+    run_wait_test(mpmc_park, messages, gap);
+
+    std::cout << "\nTesting UltraFastSPSC RingBuffer + SpinParkWait, busy..." << std::endl;
+    SPSC_RingBufferUltraFast<long long, capacity, SpinParkWait<>> ultrafast_park;
+    run_test(ultrafast_park, iterations);
 
     return 0;
 }
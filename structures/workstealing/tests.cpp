@@ -0,0 +1,200 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <sys/resource.h>
+#include "workstealing.cpp"
+
+// Owner pushes & pops from the bottom, thieves steal from the top; every item must be taken exactly once
+void run_deque_test(long long items, int thieves) {
+    ChaseLevDeque<long long> deque(64);     // Small on purpose: the owner grows it under the thieves' feet
+    std::atomic<bool> done{false};
+    std::atomic<long long> stolen_sum{0}, stolen_count{0};
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thieves; ++i) {
+        threads.emplace_back([&]() {
+            long long sum = 0, count = 0, value;
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (deque.steal(value)) {
+                    sum += value;
+                    ++count;
+                }
+            }
+            stolen_sum.fetch_add(sum);
+            stolen_count.fetch_add(count);
+        });
+    }
+
+    long long own_sum = 0, own_count = 0, value;
+    for (long long i = 1; i <= items; ++i) {
+        deque.push(i);
+        if ((i & 3) == 0 && deque.pop(value)) {    // The owner keeps a quarter of the work
+            own_sum += value;
+            ++own_count;
+        }
+    }
+    while (deque.pop(value)) {
+        own_sum += value;
+        ++own_count;
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+    const bool ok = own_count + stolen_count == items && own_sum + stolen_sum == items * (items + 1) / 2;
+    std::cout << "Time: " << diff.count() << " s \nOps/sec: " << (items / diff.count()) / 1e6 << " M"
+              << "   Stolen: " << 100.0 * stolen_count / items << " %" << (ok ? "" : "   LOST OR DUPLICATED ITEMS") << "\n";
+}
+
+long long fib_seq(int n) { return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2); }
+
+long long fib_par(WorkStealingPool& pool, int n, int cutoff) {
+    if (n < cutoff) return fib_seq(n);
+
+    long long a = 0;
+    TaskGroup group(pool);
+    group.run([&] { a = fib_par(pool, n - 1, cutoff); });
+    const long long b = fib_par(pool, n - 2, cutoff);
+    group.wait();
+    return a + b;
+}
+
+void print_stats(const WorkStealingPool& pool) {
+    const auto stats = pool.stats();
+    std::cout << "Executed: " << stats.executed << "   Stolen: " << stats.stolen << "   Injected: " << stats.injected << "\n";
+}
+
+// Fork-join: recursive fib, cutoff decides the task size
+void run_fork_join_test(WorkStealingPool& pool, int n, int cutoff) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const long long expected = fib_seq(n);
+    std::chrono::duration<double> seq = std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    long long result = 0;
+    {
+        TaskGroup root(pool);
+        root.run([&] { result = fib_par(pool, n, cutoff); });
+    }
+    std::chrono::duration<double> par = std::chrono::high_resolution_clock::now() - start;
+
+    std::cout << "Sequential: " << seq.count() << " s   Pool: " << par.count() << " s   Speedup: " << seq.count() / par.count()
+              << (result == expected ? "" : "   WRONG RESULT") << "\n";
+}
+
+// parallel_for over an array: sum of squares, grain-sized leaves
+void run_parallel_for_test(WorkStealingPool& pool, std::size_t size, std::size_t grain) {
+    std::vector<long long> data(size);
+    std::iota(data.begin(), data.end(), 0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    long long expected = 0;
+    for (long long v : data) expected += v * v;
+    std::chrono::duration<double> seq = std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    std::atomic<long long> total{0};
+    pool.parallel_for(0, size, grain, [&](std::size_t begin, std::size_t end) {
+        long long sum = 0;
+        for (std::size_t i = begin; i < end; ++i) sum += data[i] * data[i];
+        total.fetch_add(sum, std::memory_order_relaxed);
+    });
+    std::chrono::duration<double> par = std::chrono::high_resolution_clock::now() - start;
+
+    std::cout << "Sequential: " << seq.count() << " s   Pool: " << par.count() << " s   Speedup: " << seq.count() / par.count()
+              << (total.load() == expected ? "" : "   WRONG RESULT") << "\n";
+}
+
+// Fine-grained: `tasks` near-empty tasks, forked from a worker (own deque) or from outside (MPMC queue)
+void run_fine_grained_test(WorkStealingPool& pool, long long tasks, bool from_worker) {
+    std::atomic<long long> counter{0};
+    auto spawn = [&] {
+        TaskGroup group(pool);
+        for (long long i = 0; i < tasks; ++i) {
+            group.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    if (from_worker) {
+        TaskGroup root(pool);
+        root.run(spawn);
+    } else {
+        spawn();
+    }
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+
+    std::cout << "Time: " << diff.count() << " s \nTasks/sec: " << (tasks / diff.count()) / 1e6 << " M"
+              << (counter.load() == tasks ? "" : "   TASKS LOST") << "\n";
+}
+
+// One task at a time with a gap: workers park between tasks, each submit should wake one of them
+// Voluntary context switches count the parks; a herd wake costs one per sleeping worker
+void run_sparse_submit_test(std::size_t workers, long long tasks, std::chrono::microseconds gap) {
+    auto switches = [] {    // Workers only: the process minus this thread's own sleeps
+        rusage all{}, self{};
+        getrusage(RUSAGE_SELF, &all);
+        getrusage(RUSAGE_THREAD, &self);
+        return all.ru_nvcsw - self.ru_nvcsw;
+    };
+
+    WorkStealingPool pool(workers);
+    std::atomic<long long> counter{0};
+    const long before = switches();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (long long i = 0; i < tasks; ++i) {
+        pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        std::this_thread::sleep_for(gap);
+    }
+    while (counter.load(std::memory_order_relaxed) != tasks) std::this_thread::yield();
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+
+    std::cout << "Time: " << diff.count() << " s \nContext switches per task: " << double(switches() - before) / tasks
+              << " (" << workers << " workers)" << (counter.load() == tasks ? "" : "   TASKS LOST") << "\n";
+}
+
+int main()
+{
+    const long long items = 1e7;
+    const long long tasks = 1e6;
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << "Testing ChaseLevDeque, owner alone..." << std::endl;
+    run_deque_test(items, 0);
+
+    std::cout << "\nTesting ChaseLevDeque, owner + 3 thieves..." << std::endl;
+    run_deque_test(items, 3);
+
+    WorkStealingPool pool(threads);
+    std::cout << "\nWorkStealingPool, " << pool.size() << " workers" << std::endl;
+
+    std::cout << "\nTesting fork-join, fib(36), cutoff 20..." << std::endl;
+    run_fork_join_test(pool, 36, 20);
+    print_stats(pool);
+
+    std::cout << "\nTesting fork-join, fib(30), cutoff 2 (tasks of a few ns)..." << std::endl;
+    run_fork_join_test(pool, 30, 2);
+    print_stats(pool);
+
+    std::cout << "\nTesting parallel_for, 64M elements, grain 16K..." << std::endl;
+    run_parallel_for_test(pool, 64 * 1024 * 1024, 16 * 1024);
+    print_stats(pool);
+
+    std::cout << "\nTesting fine-grained tasks, forked from a worker..." << std::endl;
+    run_fine_grained_test(pool, tasks, true);
+    print_stats(pool);
+
+    std::cout << "\nTesting fine-grained tasks, submitted from outside..." << std::endl;
+    run_fine_grained_test(pool, tasks, false);
+    print_stats(pool);
+
+    std::cout << "\nTesting sparse submissions, 20 us apart..." << std::endl;
+    run_sparse_submit_test(8, 20'000, std::chrono::microseconds(20));
+
+    return 0;
+}
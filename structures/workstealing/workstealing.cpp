@@ -0,0 +1,350 @@
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "../ringbuffer/ringbuffer.cpp"    // NonCopyableNonMoveable, SpinParkWait, MPMC_BoundedQueue
+
+/*  Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli: "Correct and Efficient
+*   Work-Stealing for Weak Memory Models", PPoPP'13)
+*   Owner: push() / pop() at the bottom, LIFO, no CAS except for the last item
+*   Thieves: steal() at the top, FIFO, one CAS
+*   The array grows by the owner only; old arrays stay alive until the deque dies, a thief may still read them
+*   T lives in std::atomic<T>: a pointer or a small index
+*/
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class ChaseLevDeque : private NonCopyableNonMoveable {
+    static constexpr std::size_t CacheLine = 64;
+
+    struct Array {
+        explicit Array(std::size_t capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+        std::size_t capacity() const noexcept { return mask + 1; }
+        T load(int64_t i) const noexcept { return slots[i & mask].load(std::memory_order_relaxed); }
+        void store(int64_t i, T value) noexcept { slots[i & mask].store(value, std::memory_order_relaxed); }
+
+        const std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Array* grow(Array* old, int64_t t, int64_t b) {
+        auto bigger = std::make_unique<Array>(old->capacity() * 2);
+        for (int64_t i = t; i < b; ++i) bigger->store(i, old->load(i));
+
+        retired.emplace_back(old);
+        Array* fresh = bigger.release();
+        array.store(fresh, std::memory_order_release);
+        return fresh;
+    }
+
+public:
+    explicit ChaseLevDeque(std::size_t capacity = 1024)
+        : array(new Array(std::bit_ceil(std::max<std::size_t>(capacity, 2)))) {}
+
+    ~ChaseLevDeque() { delete array.load(std::memory_order_relaxed); }
+
+    // Owner only
+    void push(T value) {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<int64_t>(a->capacity()) - 1) [[unlikely]] {
+            a = grow(a, t, b);
+        }
+
+        a->store(b, value);
+        bottom.store(b + 1, std::memory_order_release); // MB off, a release store instead of the paper's fence
+    }
+
+    // Owner only
+    bool pop(T& value) {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // The bottom store before the top load
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {    // Empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        value = a->load(b);
+        if (t == b) {   // The last item: the thieves race for it too
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread; false when empty or another thief (or the owner) won the race
+    bool steal(T& value) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // The top load before the bottom load
+        const int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b) return false;
+
+        Array* a = array.load(std::memory_order_acquire);   // consume in the paper
+        value = a->load(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // Approximate
+    std::size_t size() const noexcept {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+private:
+    // Thieves' group
+    alignas(CacheLine) std::atomic<int64_t> top{0};
+
+    // Owner's group
+    alignas(CacheLine) std::atomic<int64_t> bottom{0};
+    std::atomic<Array*> array;
+    std::vector<std::unique_ptr<Array>> retired;    // local
+};
+
+struct PoolStats {
+    uint64_t executed = 0;
+    uint64_t stolen = 0;        // Tasks taken from another worker's deque
+    uint64_t injected = 0;      // Tasks taken from the submission queue of outside threads
+};
+
+/*  Fixed-size thread pool on Chase-Lev deques
+*   A worker: own deque (LIFO) -> outside submissions -> steals from random victims (FIFO)
+*   Idle workers spin a little, then park in SpinParkWait; a submission wakes one of them, only if someone sleeps
+*   Outside threads submit through a bounded MPMC queue and wait on a full one
+*   Joins help instead of blocking: TaskGroup::wait() runs pending tasks, so nested fork-join can't deadlock
+*   Tasks must not throw, the destructor runs everything that was submitted before it
+*/
+class WorkStealingPool : private NonCopyableNonMoveable {
+    static constexpr std::size_t CacheLine = 64;
+    static constexpr std::size_t InjectCapacity = 4 * 1024;
+    static constexpr std::size_t NotAWorker = std::numeric_limits<std::size_t>::max();
+
+    struct Task {
+        virtual void run() = 0;
+        virtual ~Task() = default;
+    };
+
+    template <typename F>
+    struct FnTask final : Task {
+        template <typename G>
+        explicit FnTask(G&& f) : func(std::forward<G>(f)) {}
+        void run() override { func(); }
+        F func;
+    };
+
+    struct alignas(CacheLine) Worker {
+        ChaseLevDeque<Task*>    deque;
+        uint64_t                rng;
+        std::atomic<uint64_t>   executed{0};    // Owner writes, stats() reads
+        std::atomic<uint64_t>   stolen{0};
+        std::atomic<uint64_t>   injected{0};
+        std::thread             thread;
+    };
+
+    struct Context {
+        const WorkStealingPool* pool = nullptr;
+        std::size_t index = NotAWorker;
+    };
+
+    static Context& context() noexcept {
+        thread_local Context ctx;
+        return ctx;
+    }
+
+    static uint64_t next_random(uint64_t& state) noexcept {    // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    static void bump(std::atomic<uint64_t>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::size_t worker_index() const noexcept {
+        const auto& ctx = context();
+        return ctx.pool == this ? ctx.index : NotAWorker;
+    }
+
+    // Every victim once, starting from a random one
+    bool steal_any(std::size_t self, uint64_t& rng, Task*& task) {
+        const std::size_t n = workers.size();
+        const std::size_t start = next_random(rng) % n;
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t victim = (start + i) % n;
+            if (victim != self && workers[victim]->deque.steal(task)) return true;
+        }
+        return false;
+    }
+
+    bool find_work(Worker& self, std::size_t index, Task*& task) {
+        if (self.deque.pop(task)) return true;
+        if (injected.pop(task)) {
+            bump(self.injected);
+            return true;
+        }
+        if (steal_any(index, self.rng, task)) {
+            bump(self.stolen);
+            return true;
+        }
+        return false;
+    }
+
+    static void execute(Task* task) {
+        task->run();
+        delete task;
+    }
+
+    void worker_loop(std::size_t index) {
+        context() = {this, index};
+        Worker& self = *workers[index];
+
+        while (true) {
+            Task* task = nullptr;
+            idle.wait([&] { return find_work(self, index, task) || stop.load(std::memory_order_acquire); });
+            if (!task) return;  // Stopped and nothing left to steal
+
+            execute(task);
+            bump(self.executed);
+        }
+    }
+
+    void enqueue(Task* task) {
+        const std::size_t index = worker_index();
+        if (index != NotAWorker) [[likely]] {
+            workers[index]->deque.push(task);
+        } else {
+            injected.push_wait(task);
+        }
+        idle.notify_one();  // One task, one worker: no herd
+    }
+
+public:
+    explicit WorkStealingPool(std::size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<std::size_t>(threads, 1);
+        workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+            workers.back()->rng = 0x9E3779B97F4A7C15ull * (i + 1);
+        }
+        // Deques exist before any thread may steal from them
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers[i]->thread = std::thread([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        stop.store(true, std::memory_order_release);
+        idle.notify();      // Every worker must see the stop
+        for (auto& worker : workers) worker->thread.join();
+    }
+
+    std::size_t size() const noexcept { return workers.size(); }
+
+    // From a worker: its own deque, no allocation besides the task; from outside: the MPMC queue
+    template <typename F>
+    void submit(F&& func) {
+        enqueue(new FnTask<std::decay_t<F>>(std::forward<F>(func)));
+    }
+
+    // One pending task on the calling thread, false if none was found
+    bool try_run_one() {
+        Task* task = nullptr;
+        const std::size_t index = worker_index();
+
+        if (index != NotAWorker) {
+            Worker& self = *workers[index];
+            if (!find_work(self, index, task)) return false;
+            execute(task);
+            bump(self.executed);
+            return true;
+        }
+
+        thread_local uint64_t rng = (0x2545F4914F6CDD1Dull ^ reinterpret_cast<uintptr_t>(&rng)) | 1;
+        if (!injected.pop(task) && !steal_any(NotAWorker, rng, task)) return false;
+        execute(task);
+        return true;
+    }
+
+    // Fork-join over [first, last): halves are forked until `grain` is left, idle workers steal the big ones
+    // body(begin, end) runs on a subrange
+    template <typename F>
+    void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F&& body);
+
+    PoolStats stats() const noexcept {
+        PoolStats total;
+        for (const auto& worker : workers) {
+            total.executed += worker->executed.load(std::memory_order_relaxed);
+            total.stolen += worker->stolen.load(std::memory_order_relaxed);
+            total.injected += worker->injected.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    std::vector<std::unique_ptr<Worker>>                        workers;
+    MPMC_BoundedQueue<Task*, InjectCapacity, SpinYieldWait<>>   injected;
+    alignas(CacheLine) SpinParkWait<>                           idle;
+    alignas(CacheLine) std::atomic<bool>                        stop{false};
+};
+
+/*  Fork-join scope: run() forks, wait() joins by helping; the destructor joins too
+*   Any thread may own a group, groups nest freely
+*/
+class TaskGroup : private NonCopyableNonMoveable {
+public:
+    explicit TaskGroup(WorkStealingPool& pool) : pool(pool) {}
+    ~TaskGroup() { wait(); }
+
+    template <typename F>
+    void run(F&& func) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, func = std::forward<F>(func)]() mutable {
+            func();
+            pending.fetch_sub(1, std::memory_order_release);    // The last touch of the group
+        });
+    }
+
+    void wait() {
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (!pool.try_run_one()) std::this_thread::yield();   // Our tasks run elsewhere
+        }
+    }
+
+private:
+    WorkStealingPool&       pool;
+    std::atomic<uint64_t>   pending{0};
+};
+
+template <typename F>
+void WorkStealingPool::parallel_for(std::size_t first, std::size_t last, std::size_t grain, F&& body) {
+    grain = std::max<std::size_t>(grain, 1);
+    TaskGroup group(*this);
+
+    auto split = [&group, grain, &body](auto& self, std::size_t begin, std::size_t end) -> void {
+        while (end - begin > grain) {
+            const std::size_t mid = begin + (end - begin) / 2;
+            group.run([&self, mid, end] { self(self, mid, end); });
+            end = mid;
+        }
+        body(begin, end);
+    };
+
+    if (first < last) split(split, first, last);
+    group.wait();
+}